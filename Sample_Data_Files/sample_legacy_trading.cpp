@@ -3,50 +3,721 @@
  * Financial Trading Platform - C++ Implementation
  * Contains embedded business rules for trade validation and risk assessment
  * Legacy Code Base - Circa 1995-2000
+ *
+ * Build: g++ -std=c++17 -O2 -pthread sample_legacy_trading.cpp
+ * Run with --bench for the validation benchmarks.
+ * Build with -DRISK_ALLOCATION_CHECK and run with --alloc-check to verify
+ * that order validation does not allocate.
+ * Run with --portfolio-check to compare validatePortfolioRisk against the
+ * two-pass reference on randomized portfolios.
+ * Run with --concurrency-check to race validators on shared trader state
+ * (best run from a -fsanitize=thread build).
+ * Run with --market-check to race market-condition readers against the
+ * seqlock publisher and check that no torn snapshot is ever observed.
+ * Run with --reload-check to race ReloadableLimitsPolicy readers against
+ * reloads (best run from a -fsanitize=address build).
+ * Build with -DRISK_WITH_LIBNUMA and link -lnuma to place trader state on
+ * explicit NUMA nodes; without it placement falls back to first touch.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
-#include <map>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#ifdef RISK_WITH_LIBNUMA
+#include <numa.h>
+#endif
+
+#ifdef RISK_ALLOCATION_CHECK
+// Counting global allocator for the --alloc-check self-test
+std::atomic<uint64_t> allocation_count{0};
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    std::size_t alignment = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) return p;
+    throw std::bad_alloc();
+}
+
+// Out of line so that GCC, seeing new and delete inlined around the
+// replaced operators, does not flag std::free as a mismatched deallocator
+__attribute__((noinline)) void releaseAllocation(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p) noexcept { releaseAllocation(p); }
+void operator delete(void* p, std::size_t) noexcept { releaseAllocation(p); }
+void operator delete(void* p, std::align_val_t) noexcept { releaseAllocation(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { releaseAllocation(p); }
+#endif
+
+// Fixed-point amount in 1e-4 units, used for prices, quantities and notionals
+// so that limit checks are exact integer compares.
+struct Fixed {
+    int64_t raw;
+
+    static constexpr int64_t SCALE = 10000;
+
+    static constexpr Fixed fromUnits(int64_t units) { return Fixed{units * SCALE}; }
+    static constexpr Fixed max() { return Fixed{INT64_MAX}; }
+
+    // Rounds to the nearest tick; saturates values outside the int64 range.
+    // NaN maps to max(), so a malformed amount trips every upper limit.
+    static Fixed fromDouble(double value) {
+        double scaled = std::round(value * SCALE);
+        if (std::isnan(scaled) || scaled >= 9.2e18) return Fixed{INT64_MAX};
+        if (scaled <= -9.2e18) return Fixed{-INT64_MAX};
+        return Fixed{static_cast<int64_t>(scaled)};
+    }
+
+    double toDouble() const { return static_cast<double>(raw) / SCALE; }
+};
+
+constexpr bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+constexpr bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+constexpr bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+constexpr bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+
+// Overflow-checked a * b, rounded half away from zero to the nearest tick.
+// Returns false (and leaves out untouched) if the product does not fit.
+inline bool checkedMultiply(Fixed a, Fixed b, Fixed& out) {
+    __int128 product = static_cast<__int128>(a.raw) * b.raw;
+    __int128 half = product < 0 ? -Fixed::SCALE / 2 : Fixed::SCALE / 2;
+    __int128 scaled = (product + half) / Fixed::SCALE;
+    if (scaled > INT64_MAX || scaled < -INT64_MAX) {
+        return false;
+    }
+    out.raw = static_cast<int64_t>(scaled);
+    return true;
+}
+
+// Exact a > b * numerator / denominator, without rounding or overflow.
+// Widens to 128 bits only when a 64-bit product would overflow.
+inline bool exceedsFraction(Fixed a, Fixed b, int64_t numerator, int64_t denominator) {
+    int64_t lhs, rhs;
+    if (!__builtin_mul_overflow(a.raw, denominator, &lhs) &&
+        !__builtin_mul_overflow(b.raw, numerator, &rhs)) {
+        return lhs > rhs;
+    }
+    return static_cast<__int128>(a.raw) * denominator > static_cast<__int128>(b.raw) * numerator;
+}
 
 // Business Rule Constants
-const double MAX_POSITION_SIZE = 10000000.0;     // $10M max position
-const double MAX_DAILY_LOSS = 500000.0;         // $500K daily loss limit
-const double MIN_ACCOUNT_BALANCE = 50000.0;     // $50K minimum balance
-const double MAX_LEVERAGE_RATIO = 10.0;         // 10:1 max leverage
-const double HIGH_RISK_THRESHOLD = 0.75;        // 75% risk threshold
-const int MAX_TRADES_PER_DAY = 100;             // Daily trade limit
-const double MARGIN_CALL_THRESHOLD = 0.25;     // 25% margin call level
-const double FORCED_LIQUIDATION = 0.10;        // 10% forced liquidation
-const int MIN_TRADING_EXPERIENCE = 2;          // 2 years minimum experience
-const double MAX_SECTOR_CONCENTRATION = 0.30;  // 30% max sector exposure
-const double VIX_HALT_THRESHOLD = 40.0;        // VIX threshold for trading halt
-const double MAX_ORDER_SIZE = 1000000.0;       // $1M max single order
-const int PATTERN_DAY_TRADER_LIMIT = 25000;    // PDT rule minimum
-
-struct TraderProfile {
+// The firm's standard limit set, as compile-time constants. Used through
+// CompiledLimitsPolicy, every limit check folds to an immediate compare.
+struct FirmLimits {
+    static constexpr double MAX_POSITION_SIZE = 10000000.0;     // $10M max position
+    static constexpr Fixed MAX_DAILY_LOSS = Fixed::fromUnits(500000);  // $500K daily loss limit
+    static constexpr Fixed MIN_ACCOUNT_BALANCE = Fixed::fromUnits(50000);  // $50K minimum balance
+    static constexpr double MAX_LEVERAGE_RATIO = 10.0;         // 10:1 max leverage
+    static constexpr double HIGH_RISK_THRESHOLD = 0.75;        // 75% risk threshold
+    static constexpr int MAX_TRADES_PER_DAY = 100;             // Daily trade limit
+    static constexpr double MARGIN_CALL_THRESHOLD = 0.25;     // 25% margin call level
+    static constexpr double FORCED_LIQUIDATION = 0.10;        // 10% forced liquidation
+    static constexpr int MIN_TRADING_EXPERIENCE = 2;          // 2 years minimum experience
+    static constexpr double MAX_SECTOR_CONCENTRATION = 0.30;  // 30% max sector exposure
+    static constexpr double VIX_HALT_THRESHOLD = 40.0;        // VIX threshold for trading halt
+    static constexpr Fixed MAX_ORDER_SIZE = Fixed::fromUnits(1000000);   // $1M max single order
+    static constexpr Fixed PATTERN_DAY_TRADER_LIMIT = Fixed::fromUnits(25000);  // PDT rule minimum
+    static constexpr bool SUSPEND_ON_DAILY_LOSS_LIMIT = true;  // Kill switch on daily loss breach
+    static constexpr double LOW_RISK_MAX_VOLATILITY = 0.8;    // Volatility cap for low-risk traders
+    static constexpr Fixed RETAIL_SHORT_LIMIT = Fixed::fromUnits(100000);  // $100K max retail short
+    static constexpr int64_t MARGIN_ORDER_MULTIPLE = 2;       // Margin orders up to 2x available margin
+    static constexpr int AFTER_HOURS_MIN_EXPERIENCE = 5;      // 5 years for extended-hours trading
+
+    // Validators read limits as lim->NAME from whatever the policy hands out
+    const FirmLimits* operator->() const { return this; }
+};
+
+// A limit set loaded at runtime, with the same members as FirmLimits
+struct LimitSet {
+    double MAX_POSITION_SIZE;
+    Fixed MAX_DAILY_LOSS;
+    Fixed MIN_ACCOUNT_BALANCE;
+    double MAX_LEVERAGE_RATIO;
+    double HIGH_RISK_THRESHOLD;
+    int MAX_TRADES_PER_DAY;
+    double MARGIN_CALL_THRESHOLD;
+    double FORCED_LIQUIDATION;
+    int MIN_TRADING_EXPERIENCE;
+    double MAX_SECTOR_CONCENTRATION;
+    double VIX_HALT_THRESHOLD;
+    Fixed MAX_ORDER_SIZE;
+    Fixed PATTERN_DAY_TRADER_LIMIT;
+    bool SUSPEND_ON_DAILY_LOSS_LIMIT;
+    double LOW_RISK_MAX_VOLATILITY;
+    Fixed RETAIL_SHORT_LIMIT;
+    int64_t MARGIN_ORDER_MULTIPLE;
+    int AFTER_HOURS_MIN_EXPERIENCE;
+
+    static LimitSet firmDefaults() {
+        return LimitSet{
+            FirmLimits::MAX_POSITION_SIZE, FirmLimits::MAX_DAILY_LOSS,
+            FirmLimits::MIN_ACCOUNT_BALANCE, FirmLimits::MAX_LEVERAGE_RATIO,
+            FirmLimits::HIGH_RISK_THRESHOLD, FirmLimits::MAX_TRADES_PER_DAY,
+            FirmLimits::MARGIN_CALL_THRESHOLD, FirmLimits::FORCED_LIQUIDATION,
+            FirmLimits::MIN_TRADING_EXPERIENCE, FirmLimits::MAX_SECTOR_CONCENTRATION,
+            FirmLimits::VIX_HALT_THRESHOLD, FirmLimits::MAX_ORDER_SIZE,
+            FirmLimits::PATTERN_DAY_TRADER_LIMIT, FirmLimits::SUSPEND_ON_DAILY_LOSS_LIMIT,
+            FirmLimits::LOW_RISK_MAX_VOLATILITY, FirmLimits::RETAIL_SHORT_LIMIT,
+            FirmLimits::MARGIN_ORDER_MULTIPLE, FirmLimits::AFTER_HOURS_MIN_EXPERIENCE
+        };
+    }
+};
+
+// Limits policies for BasicTradingRiskManager. snapshot() returns something
+// usable as lim->NAME for the duration of one validation.
+struct CompiledLimitsPolicy {
+    FirmLimits snapshot() const { return FirmLimits(); }
+};
+
+class RuntimeLimitsPolicy {
+private:
+    LimitSet limits = LimitSet::firmDefaults();
+
+public:
+    const LimitSet* snapshot() const { return &limits; }
+
+    // Not synchronized with concurrent validations
+    void load(const LimitSet& new_limits) { limits = new_limits; }
+};
+
+// Asymmetric fence pair for read-mostly publication. A reader announcing
+// itself calls lightFence() between its announcing store and its next load;
+// a writer calls heavyFence() between publishing and scanning the readers.
+// Where the kernel offers an expedited membarrier, heavyFence() forces a
+// full barrier on every CPU running one of our threads, so lightFence() can
+// be a compiler barrier. Otherwise both sides pay a seq_cst fence.
+class AsymmetricFence {
+private:
+    static bool registerExpedited() {
+#if defined(__linux__) && defined(MEMBARRIER_CMD_PRIVATE_EXPEDITED)
+        return syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+#else
+        return false;
+#endif
+    }
+
+public:
+    static bool expedited() {
+        static const bool registered = registerExpedited();
+        return registered;
+    }
+
+    static void lightFence() {
+        if (expedited()) {
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        } else {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    static void heavyFence() {
+#if defined(__linux__) && defined(MEMBARRIER_CMD_PRIVATE_EXPEDITED)
+        if (expedited()) {
+            syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+            return;
+        }
+#endif
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+};
+
+// A limit set that can be swapped while validations run. Readers never
+// lock, and the first kMaxReaderThreads never write a shared cache line:
+// each owns one slot, where snapshot() records the epoch it entered with
+// plain stores, and the guard clears it on scope exit. load() publishes
+// the new set, advances the epoch and frees the old set once no slot still
+// holds an epoch from before the swap and the overflow readers counted
+// before it are done, so in-flight validations complete on the limits they
+// started with. Snapshots may nest on one thread.
+class ReloadableLimitsPolicy {
+public:
+    // Reader threads with a slot of their own; each claims a slot index on
+    // its first snapshot and returns it when it exits. Threads beyond these
+    // count themselves into a shared overflow counter instead.
+    static constexpr unsigned kMaxReaderThreads = 256;
+
+private:
+    // Written only by its owner thread; the reloader only reads epoch
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};  // 0: not reading
+        uint32_t depth = 0;
+    };
+
+    static constexpr unsigned kOverflowReader = kMaxReaderThreads;
+
+    class ReaderIndex {
+    private:
+        static std::atomic<uint64_t>* claimed() {
+            static std::atomic<uint64_t> words[kMaxReaderThreads / 64] = {};
+            return words;
+        }
+
+    public:
+        unsigned index = kOverflowReader;
+
+        ReaderIndex() {
+            for (unsigned w = 0; w < kMaxReaderThreads / 64 && index == kOverflowReader; ++w) {
+                uint64_t bits = claimed()[w].load(std::memory_order_relaxed);
+                while (~bits != 0) {
+                    uint64_t bit = ~bits & (bits + 1);
+                    if (claimed()[w].compare_exchange_weak(bits, bits | bit, std::memory_order_acquire)) {
+                        index = w * 64 + __builtin_ctzll(bit);
+                        break;
+                    }
+                }
+            }
+        }
+        ~ReaderIndex() {
+            if (index != kOverflowReader) {
+                claimed()[index / 64].fetch_and(~(1ull << (index % 64)), std::memory_order_release);
+            }
+        }
+    };
+
+    std::atomic<const LimitSet*> current;
+    std::atomic<uint64_t> epoch{1};
+    mutable ReaderSlot readers[kMaxReaderThreads];
+    // Snapshots held by overflow readers, in the counter overflow_phase
+    // picked when each was taken. A reload flips the phase and waits for
+    // the old counter to drain, twice, so a reader that picked its counter
+    // before an earlier flip is waited for too, and readers arriving during
+    // the wait count into the other counter and cannot hold it up.
+    mutable std::atomic<uint64_t> overflow_readers[2] = {};
+    std::atomic<unsigned> overflow_phase{0};
+    std::mutex reload_mutex;
+
+    // Claims the thread's index; the ReaderIndex returns it at thread exit
+    __attribute__((noinline)) static unsigned claimReaderIndex() {
+        thread_local ReaderIndex reader;
+        return reader.index;
+    }
+
+    // A trivially initialized copy, so the hot path needs no TLS guard check
+    static unsigned readerIndex() {
+        thread_local unsigned index = ~0u;
+        if (__builtin_expect(index == ~0u, 0)) {
+            index = claimReaderIndex();
+        }
+        return index;
+    }
+
+    // The fence orders the count before the caller reads current, as
+    // lightFence() does for an owned slot
+    __attribute__((noinline)) std::atomic<uint64_t>* enterOverflow() const {
+        std::atomic<uint64_t>* count = &overflow_readers[overflow_phase.load(std::memory_order_acquire) & 1];
+        count->fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return count;
+    }
+
+public:
+    class ReadGuard {
+    private:
+        ReaderSlot* slot;                 // null for an overflow reader
+        std::atomic<uint64_t>* overflow;  // its counter
+        const LimitSet* limits;
+
+    public:
+        ReadGuard(ReaderSlot* reader, std::atomic<uint64_t>* count, const LimitSet* pinned)
+            : slot(reader), overflow(count), limits(pinned) {}
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ~ReadGuard() {
+            if (__builtin_expect(slot == nullptr, 0)) {
+                overflow->fetch_sub(1, std::memory_order_release);
+            } else if (--slot->depth == 0) {
+                slot->epoch.store(0, std::memory_order_release);
+            }
+        }
+
+        const LimitSet* operator->() const { return limits; }
+    };
+
+    ReloadableLimitsPolicy() : current(new LimitSet(LimitSet::firmDefaults())) {
+        AsymmetricFence::expedited();
+    }
+    ReloadableLimitsPolicy(const ReloadableLimitsPolicy&) = delete;
+    ReloadableLimitsPolicy& operator=(const ReloadableLimitsPolicy&) = delete;
+    ~ReloadableLimitsPolicy() { delete current.load(std::memory_order_relaxed); }
+
+    ReadGuard snapshot() const {
+        const unsigned index = readerIndex();
+        if (__builtin_expect(index == kOverflowReader, 0)) {
+            std::atomic<uint64_t>* count = enterOverflow();
+            return ReadGuard(nullptr, count, current.load(std::memory_order_acquire));
+        }
+        ReaderSlot& slot = readers[index];
+        if (slot.depth++ == 0) {
+            // The announcement must be visible before current is read, or
+            // a reload scanning in between could free the set read below
+            slot.epoch.store(epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+            AsymmetricFence::lightFence();
+        }
+        return ReadGuard(&slot, nullptr, current.load(std::memory_order_acquire));
+    }
+
+    // Safe to call while validations run; returns once the old set is freed
+    void load(const LimitSet& new_limits) {
+        std::lock_guard<std::mutex> lock(reload_mutex);
+        const LimitSet* retired = current.exchange(new LimitSet(new_limits), std::memory_order_acq_rel);
+        uint64_t old_epoch = epoch.fetch_add(1, std::memory_order_acq_rel);
+        AsymmetricFence::heavyFence();
+        // A reader that entered at old_epoch or earlier may hold retired;
+        // later readers see the new epoch and therefore the new set
+        for (const ReaderSlot& slot : readers) {
+            for (;;) {
+                uint64_t entered = slot.epoch.load(std::memory_order_acquire);
+                if (entered == 0 || entered > old_epoch) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+        for (int flip = 0; flip < 2; ++flip) {
+            const unsigned drained = overflow_phase.fetch_xor(1, std::memory_order_acq_rel) & 1;
+            while (overflow_readers[drained].load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+        }
+        delete retired;
+    }
+};
+
+// Categorical codes, parsed once at ingestion. The string fields are kept
+// for the boundary (input records, reports); validators branch on codes.
+enum class RiskLevel : unsigned char { UNKNOWN, LOW, MEDIUM, HIGH };
+enum class TraderType : unsigned char { UNKNOWN, RETAIL, INSTITUTIONAL, PROPRIETARY };
+enum class OrderType : unsigned char { UNKNOWN, BUY, SELL, SHORT, MARKET };
+enum class TimeInForce : unsigned char { UNKNOWN, DAY, GTC, IOC, EXTENDED_HOURS };
+enum class Sector : unsigned char { OTHER, DIVERSIFIED, TECHNOLOGY, BIOTECH, CRYPTO };
+enum class Jurisdiction : unsigned char { OTHER, US, NY, RESTRICTED, SANCTIONED, RESTRICTED_CRYPTO };
+enum class MarketStatus : unsigned char { UNKNOWN, OPEN, PRE_MARKET, CLOSED };
+enum class PositionRisk : unsigned char { OTHER, HIGH_RISK };
+enum class ProductType : unsigned char {
+    OTHER, DERIVATIVES, STRUCTURED_PRODUCTS, HFT_ALGORITHMS, INTERNATIONAL_EQUITIES, CRYPTOCURRENCY
+};
+
+RiskLevel parseRiskLevel(const std::string& s) {
+    if (s == "LOW") return RiskLevel::LOW;
+    if (s == "MEDIUM") return RiskLevel::MEDIUM;
+    if (s == "HIGH") return RiskLevel::HIGH;
+    return RiskLevel::UNKNOWN;
+}
+
+TraderType parseTraderType(const std::string& s) {
+    if (s == "RETAIL") return TraderType::RETAIL;
+    if (s == "INSTITUTIONAL") return TraderType::INSTITUTIONAL;
+    if (s == "PROPRIETARY") return TraderType::PROPRIETARY;
+    return TraderType::UNKNOWN;
+}
+
+OrderType parseOrderType(const std::string& s) {
+    if (s == "BUY") return OrderType::BUY;
+    if (s == "SELL") return OrderType::SELL;
+    if (s == "SHORT") return OrderType::SHORT;
+    if (s == "MARKET") return OrderType::MARKET;
+    return OrderType::UNKNOWN;
+}
+
+TimeInForce parseTimeInForce(const std::string& s) {
+    if (s == "DAY") return TimeInForce::DAY;
+    if (s == "GTC") return TimeInForce::GTC;
+    if (s == "IOC") return TimeInForce::IOC;
+    if (s == "EXTENDED_HOURS") return TimeInForce::EXTENDED_HOURS;
+    return TimeInForce::UNKNOWN;
+}
+
+Sector parseSector(const std::string& s) {
+    if (s == "DIVERSIFIED") return Sector::DIVERSIFIED;
+    if (s == "TECHNOLOGY") return Sector::TECHNOLOGY;
+    if (s == "BIOTECH") return Sector::BIOTECH;
+    if (s == "CRYPTO") return Sector::CRYPTO;
+    return Sector::OTHER;
+}
+
+PositionRisk parsePositionRisk(const std::string& s) {
+    if (s == "HIGH_RISK") return PositionRisk::HIGH_RISK;
+    return PositionRisk::OTHER;
+}
+
+Jurisdiction parseJurisdiction(const std::string& s) {
+    if (s == "US") return Jurisdiction::US;
+    if (s == "NY") return Jurisdiction::NY;
+    if (s == "RESTRICTED") return Jurisdiction::RESTRICTED;
+    if (s == "SANCTIONED") return Jurisdiction::SANCTIONED;
+    if (s == "RESTRICTED_CRYPTO") return Jurisdiction::RESTRICTED_CRYPTO;
+    return Jurisdiction::OTHER;
+}
+
+// Process-wide symbol dictionary. Symbols are interned to dense 32-bit ids at
+// ingestion so per-symbol state can live in flat arrays indexed by id.
+// Interning takes a lock; the validators only ever see the ids.
+class SymbolTable {
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, uint32_t> ids;
+    std::deque<std::string> names;  // deque: references stay valid as it grows
+
+public:
+    static const uint32_t INVALID_ID = 0xFFFFFFFFu;
+
+    uint32_t intern(const std::string& symbol) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ids.find(symbol);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        uint32_t id = static_cast<uint32_t>(names.size());
+        names.push_back(symbol);
+        ids.emplace(symbol, id);
+        return id;
+    }
+
+    uint32_t find(const std::string& symbol) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ids.find(symbol);
+        return it != ids.end() ? it->second : INVALID_ID;
+    }
+
+    const std::string& name(uint32_t id) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return names.at(id);
+    }
+
+    uint32_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return static_cast<uint32_t>(names.size());
+    }
+};
+
+SymbolTable& symbolTable() {
+    static SymbolTable table;
+    return table;
+}
+
+MarketStatus parseMarketStatus(const std::string& s) {
+    if (s == "OPEN") return MarketStatus::OPEN;
+    if (s == "PRE_MARKET") return MarketStatus::PRE_MARKET;
+    if (s == "CLOSED") return MarketStatus::CLOSED;
+    return MarketStatus::UNKNOWN;
+}
+
+ProductType parseProductType(const std::string& s) {
+    if (s == "DERIVATIVES") return ProductType::DERIVATIVES;
+    if (s == "STRUCTURED_PRODUCTS") return ProductType::STRUCTURED_PRODUCTS;
+    if (s == "HFT_ALGORITHMS") return ProductType::HFT_ALGORITHMS;
+    if (s == "INTERNATIONAL_EQUITIES") return ProductType::INTERNATIONAL_EQUITIES;
+    if (s == "CRYPTOCURRENCY") return ProductType::CRYPTOCURRENCY;
+    return ProductType::OTHER;
+}
+
+// The categorical fields and amounts are only reachable through setters
+// that also refresh their parsed code or fixed-point copy, so a profile's
+// strings and doubles and the values the validators read can never disagree.
+class TraderProfile {
+public:
     int trader_id;
     std::string trader_name;
     int experience_years;
-    std::string risk_level;  // LOW, MEDIUM, HIGH
+    bool is_accredited;
+    // Dense state slot, assigned by TradingRiskManager::loginTrader(). The
+    // slot only means something in the state table named by state_table;
+    // any other manager treats the trader as not logged in.
+    uint32_t state_slot = 0xFFFFFFFFu;
+    uint32_t state_table = 0;
+
+    // Field order of the input record, so brace-initialized records still work
+    TraderProfile(int id, std::string name, int experience, const std::string& risk, double balance,
+                  double margin, const std::string& type, bool accredited, const std::string& region)
+        : trader_id(id), trader_name(std::move(name)), experience_years(experience), is_accredited(accredited) {
+        setRiskLevel(risk);
+        setAccountBalance(balance);
+        setAvailableMargin(margin);
+        setTraderType(type);
+        setJurisdiction(region);
+    }
+
+    const std::string& riskLevel() const { return risk_level; }
+    const std::string& traderType() const { return trader_type; }
+    const std::string& jurisdiction() const { return jurisdiction_name; }
+    double accountBalance() const { return account_balance; }
+    double availableMargin() const { return available_margin; }
+
+    RiskLevel riskCode() const { return risk_code; }
+    TraderType typeCode() const { return type_code; }
+    Jurisdiction jurisdictionCode() const { return jurisdiction_code; }
+    Fixed accountBalanceFx() const { return account_balance_fx; }
+    Fixed availableMarginFx() const { return available_margin_fx; }
+
+    void setRiskLevel(const std::string& level) {
+        risk_level = level;
+        risk_code = parseRiskLevel(level);
+    }
+
+    void setTraderType(const std::string& type) {
+        trader_type = type;
+        type_code = parseTraderType(type);
+    }
+
+    void setJurisdiction(const std::string& region) {
+        jurisdiction_name = region;
+        jurisdiction_code = parseJurisdiction(region);
+    }
+
+    void setAccountBalance(double balance) {
+        account_balance = balance;
+        account_balance_fx = Fixed::fromDouble(balance);
+    }
+
+    void setAvailableMargin(double margin) {
+        available_margin = margin;
+        available_margin_fx = Fixed::fromDouble(margin);
+    }
+
+private:
+    std::string risk_level;         // LOW, MEDIUM, HIGH
+    std::string trader_type;        // RETAIL, INSTITUTIONAL, PROPRIETARY
+    std::string jurisdiction_name;
     double account_balance;
     double available_margin;
-    std::string trader_type; // RETAIL, INSTITUTIONAL, PROPRIETARY
-    bool is_accredited;
-    std::string jurisdiction;
+    RiskLevel risk_code;
+    TraderType type_code;
+    Jurisdiction jurisdiction_code;
+    Fixed account_balance_fx;
+    Fixed available_margin_fx;
 };
 
-struct TradeOrder {
+// Like TraderProfile, every field the validators read through a parsed or
+// fixed-point copy is private behind a setter that refreshes the copy, so
+// a constructed order is always fully ingested. notional_fx saturates at
+// Fixed::max() if quantity * price overflows.
+class TradeOrder {
+public:
     int order_id;
-    std::string symbol;
-    std::string order_type; // BUY, SELL, SHORT
-    double quantity;
-    double price;
-    std::string time_in_force; // DAY, GTC, IOC
     bool is_margin_trade;
-    std::string sector;
     double volatility_score;
+
+    // Field order of the input record, so brace-initialized records still work
+    TradeOrder(int id, const std::string& symbol, const std::string& type, double quantity, double price,
+               const std::string& tif, bool margin_trade, const std::string& sector, double volatility)
+        : order_id(id), is_margin_trade(margin_trade), volatility_score(volatility) {
+        setSymbol(symbol);
+        setOrderType(type);
+        setQuantity(quantity);
+        setPrice(price);
+        setTimeInForce(tif);
+        setSector(sector);
+    }
+
+    const std::string& symbol() const { return symbol_name; }
+    const std::string& orderType() const { return order_type; }  // BUY, SELL, SHORT
+    double quantity() const { return quantity_value; }
+    double price() const { return price_value; }
+    const std::string& timeInForce() const { return time_in_force; }  // DAY, GTC, IOC
+    const std::string& sector() const { return sector_name; }
+
+    uint32_t symbolId() const { return symbol_id; }
+    OrderType typeCode() const { return type_code; }
+    TimeInForce tifCode() const { return tif_code; }
+    Sector sectorCode() const { return sector_code; }
+    Fixed quantityFx() const { return quantity_fx; }
+    Fixed priceFx() const { return price_fx; }
+    Fixed notionalFx() const { return notional_fx; }
+
+    void setSymbol(const std::string& symbol) {
+        symbol_name = symbol;
+        symbol_id = symbolTable().intern(symbol);
+    }
+
+    void setOrderType(const std::string& type) {
+        order_type = type;
+        type_code = parseOrderType(type);
+    }
+
+    void setQuantity(double quantity) {
+        quantity_value = quantity;
+        quantity_fx = Fixed::fromDouble(quantity);
+        updateNotional();
+    }
+
+    void setPrice(double price) {
+        price_value = price;
+        price_fx = Fixed::fromDouble(price);
+        updateNotional();
+    }
+
+    void setTimeInForce(const std::string& tif) {
+        time_in_force = tif;
+        tif_code = parseTimeInForce(tif);
+    }
+
+    void setSector(const std::string& sector) {
+        sector_name = sector;
+        sector_code = parseSector(sector);
+    }
+
+private:
+    void updateNotional() {
+        if (!checkedMultiply(quantity_fx, price_fx, notional_fx)) {
+            notional_fx = Fixed::max();
+        }
+    }
+
+    std::string symbol_name;
+    std::string order_type;
+    std::string time_in_force;
+    std::string sector_name;
+    double quantity_value = 0.0;
+    double price_value = 0.0;
+    uint32_t symbol_id = SymbolTable::INVALID_ID;
+    OrderType type_code = OrderType::UNKNOWN;
+    TimeInForce tif_code = TimeInForce::UNKNOWN;
+    Sector sector_code = Sector::OTHER;
+    Fixed quantity_fx = Fixed{0};
+    Fixed price_fx = Fixed{0};
+    Fixed notional_fx = Fixed{0};
 };
 
 struct PortfolioPosition {
@@ -55,300 +726,4507 @@ struct PortfolioPosition {
     double unrealized_pnl;
     double sector_exposure;
     std::string risk_category;
+    // Filled by ingestPortfolioPosition()
+    uint32_t symbol_id = SymbolTable::INVALID_ID;
+    PositionRisk risk_code = PositionRisk::OTHER;
 };
 
-class TradingRiskManager {
+// Ingestion: parse the categorical strings once when a record enters the
+// system. TraderProfile and TradeOrder do this in their setters.
+void ingestPortfolioPosition(PortfolioPosition& position) {
+    position.symbol_id = symbolTable().intern(position.symbol);
+    position.risk_code = parsePositionRisk(position.risk_category);
+}
+
+// Hot part of an ingested order: exactly the fields the validators read,
+// packed into one cache line. The descriptive strings stay in OrderCold.
+struct alignas(64) OrderHot {
+    int order_id;
+    uint32_t symbol_id;
+    uint32_t cold_index;  // row in the owning OrderStore's cold table
+    OrderType type_code;
+    TimeInForce tif_code;
+    Sector sector_code;
+    bool is_margin_trade;
+    Fixed notional_fx;
+    Fixed quantity_fx;
+    double volatility_score;
+};
+static_assert(sizeof(OrderHot) == 64, "OrderHot must fill exactly one cache line");
+
+// Cold part of an ingested order, only needed for reporting
+struct OrderCold {
+    std::string symbol;
+    std::string order_type;
+    std::string time_in_force;
+    std::string sector;
+    double quantity;
+    double price;
+};
+
+OrderHot makeOrderHot(const TradeOrder& order, uint32_t cold_index = 0xFFFFFFFFu) {
+    OrderHot hot = {};
+    hot.order_id = order.order_id;
+    hot.symbol_id = order.symbolId();
+    hot.cold_index = cold_index;
+    hot.type_code = order.typeCode();
+    hot.tif_code = order.tifCode();
+    hot.sector_code = order.sectorCode();
+    hot.is_margin_trade = order.is_margin_trade;
+    hot.notional_fx = order.notionalFx();
+    hot.quantity_fx = order.quantityFx();
+    hot.volatility_score = order.volatility_score;
+    return hot;
+}
+
+// A batch of ingested orders with the hot records stored contiguously and
+// the strings in a parallel cold side table
+class OrderStore {
 private:
-    std::map<int, int> daily_trade_counts;
-    std::map<int, double> daily_losses;
-    
+    std::vector<OrderHot> hot;
+    std::vector<OrderCold> cold;
+
 public:
-    
-    // Business Rule: Validate trader eligibility
-    bool validateTraderEligibility(const TraderProfile& trader) {
-        // Business Rule: Minimum experience requirement
-        if (trader.experience_years < MIN_TRADING_EXPERIENCE) {
-            std::cout << "REJECTED: Trader lacks minimum experience" << std::endl;
-            return false;
+    void reserve(size_t count) {
+        hot.reserve(count);
+        cold.reserve(count);
+    }
+
+    uint32_t add(const TradeOrder& order) {
+        uint32_t index = static_cast<uint32_t>(hot.size());
+        hot.push_back(makeOrderHot(order, index));
+        cold.push_back(OrderCold{order.symbol(), order.orderType(), order.timeInForce(),
+                                 order.sector(), order.quantity(), order.price()});
+        return index;
+    }
+
+    size_t size() const { return hot.size(); }
+    const OrderHot& operator[](size_t i) const { return hot[i]; }
+    const OrderHot* data() const { return hot.data(); }
+    const OrderCold& coldOf(const OrderHot& order) const { return cold.at(order.cold_index); }
+};
+
+// A batch of orders in columnar form for validateTradeOrderBatch: one
+// array per field the order rules read. trader[i] indexes the trader table
+// passed alongside the batch.
+struct OrderColumns {
+    std::vector<Fixed> notional;
+    std::vector<double> volatility;
+    std::vector<OrderType> type;
+    std::vector<TimeInForce> tif;
+    std::vector<uint8_t> margin;
+    std::vector<uint32_t> trader;
+
+    void reserve(size_t count) {
+        notional.reserve(count);
+        volatility.reserve(count);
+        type.reserve(count);
+        tif.reserve(count);
+        margin.reserve(count);
+        trader.reserve(count);
+    }
+
+    void clear() {
+        notional.clear();
+        volatility.clear();
+        type.clear();
+        tif.clear();
+        margin.clear();
+        trader.clear();
+    }
+
+    void add(const OrderHot& order, uint32_t trader_index) {
+        notional.push_back(order.notional_fx);
+        volatility.push_back(order.volatility_score);
+        type.push_back(order.type_code);
+        tif.push_back(order.tif_code);
+        margin.push_back(order.is_margin_trade);
+        trader.push_back(trader_index);
+    }
+
+    size_t size() const { return notional.size(); }
+};
+
+// Vector instruction sets the batch kernels are built for
+enum class SimdLevel { SCALAR, AVX2, AVX512 };
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::AVX512: return "AVX-512";
+        default: return "scalar";
+    }
+}
+
+// Widest vector unit this CPU supports, detected once. AVX512 takes the
+// VL and CD extensions along with F, as every AVX-512 Xeon has them.
+inline SimdLevel detectSimdLevel() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const SimdLevel level =
+        __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512cd")
+            ? SimdLevel::AVX512
+        : __builtin_cpu_supports("avx2") ? SimdLevel::AVX2
+                                         : SimdLevel::SCALAR;
+    return level;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+// A portfolio in columnar form for the validatePortfolioRisk overload:
+// one array per field the portfolio rules read, so the metrics pass
+// streams dense doubles instead of records carrying two strings.
+struct PortfolioStore {
+    std::vector<double> value;
+    std::vector<double> unrealized_pnl;
+    std::vector<PositionRisk> risk;
+
+    void reserve(size_t count) {
+        value.reserve(count);
+        unrealized_pnl.reserve(count);
+        risk.reserve(count);
+    }
+
+    void clear() {
+        value.clear();
+        unrealized_pnl.clear();
+        risk.clear();
+    }
+
+    void add(const PortfolioPosition& position) {
+        value.push_back(position.current_value);
+        unrealized_pnl.push_back(position.unrealized_pnl);
+        risk.push_back(position.risk_code);
+    }
+
+    size_t size() const { return value.size(); }
+};
+
+// Portfolio totals gathered in one pass over the positions
+struct PortfolioMetrics {
+    double total_value = 0.0;
+    double unrealized_loss = 0.0;
+    double high_risk_exposure = 0.0;
+    // -infinity for an empty portfolio
+    double max_position = -std::numeric_limits<double>::infinity();
+    // Largest position ahead of the first one over the position limit; a
+    // POSITION_SIZE_LIMIT rejection only carries their concentration warning
+    double max_before_oversized = -std::numeric_limits<double>::infinity();
+    bool oversized = false;
+};
+
+// Adds one position to a streaming pass. The largest position ahead of
+// the first oversized one is tracked as it goes, so no second walk is needed.
+inline void accumulatePosition(PortfolioMetrics& metrics, double value, double pnl, bool high_risk,
+                               double position_limit) {
+    metrics.total_value += value;
+    metrics.unrealized_loss += pnl < 0 ? -pnl : 0.0;
+    metrics.high_risk_exposure += high_risk ? value : 0.0;
+    metrics.max_position = value > metrics.max_position ? value : metrics.max_position;
+    metrics.oversized |= value > position_limit;
+    metrics.max_before_oversized = metrics.oversized ? metrics.max_before_oversized : metrics.max_position;
+}
+
+// Sums in position order, so the totals match a plain loop exactly
+inline void reducePortfolioScalar(const PortfolioStore& portfolio, size_t begin, PortfolioMetrics& metrics) {
+    for (size_t i = begin; i < portfolio.size(); ++i) {
+        const double value = portfolio.value[i];
+        const double pnl = portfolio.unrealized_pnl[i];
+        metrics.total_value += value;
+        metrics.unrealized_loss += pnl < 0 ? -pnl : 0.0;
+        metrics.high_risk_exposure += portfolio.risk[i] == PositionRisk::HIGH_RISK ? value : 0.0;
+        metrics.max_position = value > metrics.max_position ? value : metrics.max_position;
+    }
+}
+
+// The vector reductions keep per-lane sums and fold them at the end, so
+// their totals can differ from the sequential sum in the last bits. The
+// max is exact; max_pd(value, max) keeps max when value is NaN, as the
+// scalar compare does.
+#if defined(__x86_64__) || defined(__i386__)
+struct PortfolioLanes4 {
+    __m256d total, loss, high_risk, max;
+};
+
+__attribute__((target("avx2")))
+inline void reducePortfolio4(const PortfolioStore& portfolio, size_t i, PortfolioLanes4& lanes) {
+    const __m256d value = _mm256_loadu_pd(&portfolio.value[i]);
+    const __m256d pnl = _mm256_loadu_pd(&portfolio.unrealized_pnl[i]);
+    int32_t risk_bytes;
+    std::memcpy(&risk_bytes, &portfolio.risk[i], sizeof(risk_bytes));
+    const __m256i high_risk = _mm256_cmpeq_epi64(
+        _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(risk_bytes)),
+        _mm256_set1_epi64x(static_cast<int>(PositionRisk::HIGH_RISK)));
+    const __m256d loss = _mm256_cmp_pd(pnl, _mm256_setzero_pd(), _CMP_LT_OQ);
+    lanes.total = _mm256_add_pd(lanes.total, value);
+    lanes.loss = _mm256_sub_pd(lanes.loss, _mm256_and_pd(loss, pnl));
+    lanes.high_risk = _mm256_add_pd(lanes.high_risk, _mm256_and_pd(_mm256_castsi256_pd(high_risk), value));
+    lanes.max = _mm256_max_pd(value, lanes.max);
+}
+
+__attribute__((target("avx2")))
+inline double sumLanes(__m256d lanes) {
+    alignas(32) double lane[4];
+    _mm256_store_pd(lane, lanes);
+    return (lane[0] + lane[1]) + (lane[2] + lane[3]);
+}
+
+// Eight positions per iteration, two sets of 4-lane accumulators
+__attribute__((target("avx2")))
+void reducePortfolioAvx2(const PortfolioStore& portfolio, PortfolioMetrics& metrics) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d floor = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    PortfolioLanes4 lanes[2] = {{zero, zero, zero, floor}, {zero, zero, zero, floor}};
+    const size_t count = portfolio.size();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        reducePortfolio4(portfolio, i, lanes[0]);
+        reducePortfolio4(portfolio, i + 4, lanes[1]);
+    }
+    metrics.total_value = sumLanes(_mm256_add_pd(lanes[0].total, lanes[1].total));
+    metrics.unrealized_loss = sumLanes(_mm256_add_pd(lanes[0].loss, lanes[1].loss));
+    metrics.high_risk_exposure = sumLanes(_mm256_add_pd(lanes[0].high_risk, lanes[1].high_risk));
+    alignas(32) double lane[4];
+    _mm256_store_pd(lane, _mm256_max_pd(lanes[0].max, lanes[1].max));
+    metrics.max_position = *std::max_element(lane, lane + 4);
+    reducePortfolioScalar(portfolio, i, metrics);
+}
+
+struct PortfolioLanes8 {
+    __m512d total, loss, high_risk, max;
+};
+
+__attribute__((target("avx512f")))
+inline void reducePortfolio8(const PortfolioStore& portfolio, size_t i, PortfolioLanes8& lanes) {
+    const __m512d value = _mm512_loadu_pd(&portfolio.value[i]);
+    const __m512d pnl = _mm512_loadu_pd(&portfolio.unrealized_pnl[i]);
+    const __mmask8 high_risk = _mm512_cmpeq_epi64_mask(
+        _mm512_maskz_cvtepu8_epi64(0xFF, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&portfolio.risk[i]))),
+        _mm512_set1_epi64(static_cast<int>(PositionRisk::HIGH_RISK)));
+    const __mmask8 loss = _mm512_cmp_pd_mask(pnl, _mm512_setzero_pd(), _CMP_LT_OQ);
+    lanes.total = _mm512_add_pd(lanes.total, value);
+    lanes.loss = _mm512_mask_sub_pd(lanes.loss, loss, lanes.loss, pnl);
+    lanes.high_risk = _mm512_mask_add_pd(lanes.high_risk, high_risk, lanes.high_risk, value);
+    lanes.max = _mm512_maskz_max_pd(0xFF, value, lanes.max);
+}
+
+// Folded through memory: GCC 12 flags the _mm512_undefined_pd inside
+// _mm512_reduce_* (and _mm512_max_pd, hence the maskz max forms)
+__attribute__((target("avx512f")))
+inline double sumLanes(__m512d lanes) {
+    alignas(64) double lane[8];
+    _mm512_store_pd(lane, lanes);
+    return ((lane[0] + lane[1]) + (lane[2] + lane[3])) + ((lane[4] + lane[5]) + (lane[6] + lane[7]));
+}
+
+// Sixteen positions per iteration, two sets of 8-lane accumulators
+__attribute__((target("avx512f")))
+void reducePortfolioAvx512(const PortfolioStore& portfolio, PortfolioMetrics& metrics) {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d floor = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+    PortfolioLanes8 lanes[2] = {{zero, zero, zero, floor}, {zero, zero, zero, floor}};
+    const size_t count = portfolio.size();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        reducePortfolio8(portfolio, i, lanes[0]);
+        reducePortfolio8(portfolio, i + 8, lanes[1]);
+    }
+    metrics.total_value = sumLanes(_mm512_add_pd(lanes[0].total, lanes[1].total));
+    metrics.unrealized_loss = sumLanes(_mm512_add_pd(lanes[0].loss, lanes[1].loss));
+    metrics.high_risk_exposure = sumLanes(_mm512_add_pd(lanes[0].high_risk, lanes[1].high_risk));
+    alignas(64) double lane[8];
+    _mm512_store_pd(lane, _mm512_maskz_max_pd(0xFF, lanes[0].max, lanes[1].max));
+    metrics.max_position = *std::max_element(lane, lane + 8);
+    reducePortfolioScalar(portfolio, i, metrics);
+}
+#endif
+
+// One pass over the portfolio. position_limit is the MAX_POSITION_SIZE the
+// caller is validating against; a second, scalar pass runs only when some
+// position exceeds it. A level the CPU lacks is lowered to the widest one
+// it has.
+PortfolioMetrics reducePortfolio(const PortfolioStore& portfolio, double position_limit,
+                                 SimdLevel level = detectSimdLevel()) {
+    PortfolioMetrics metrics;
+    level = std::min(level, detectSimdLevel());
+#if defined(__x86_64__) || defined(__i386__)
+    if (level == SimdLevel::AVX512) {
+        reducePortfolioAvx512(portfolio, metrics);
+    } else if (level == SimdLevel::AVX2) {
+        reducePortfolioAvx2(portfolio, metrics);
+    } else
+#endif
+    {
+        reducePortfolioScalar(portfolio, 0, metrics);
+    }
+
+    metrics.oversized = metrics.max_position > position_limit;
+    if (!metrics.oversized) {
+        metrics.max_before_oversized = metrics.max_position;
+        return metrics;
+    }
+    for (double value : portfolio.value) {
+        if (value > position_limit) {
+            break;
+        }
+        metrics.max_before_oversized = value > metrics.max_before_oversized ? value : metrics.max_before_oversized;
+    }
+    return metrics;
+}
+
+// Outcome of a validator: accept flag, the first rule that rejected, and
+// any warnings raised on the way. Validators do no I/O; use
+// printRiskDecision() (or your own consumer) to render it.
+enum class RejectReason : unsigned char {
+    NONE,
+    INSUFFICIENT_EXPERIENCE,
+    INSUFFICIENT_BALANCE,
+    RESTRICTED_JURISDICTION,
+    ACCREDITATION_REQUIRED,
+    FIRM_KILL_SWITCH,
+    TRADER_SUSPENDED,
+    ORDER_SIZE_LIMIT,
+    VOLATILITY_RESTRICTED,
+    RETAIL_SHORT_LIMIT,
+    INSUFFICIENT_MARGIN,
+    TRADER_CAPACITY_EXCEEDED,
+    DAILY_TRADE_LIMIT,
+    AFTER_HOURS_EXPERIENCE,
+    POSITION_SIZE_LIMIT,
+    HIGH_RISK_EXPOSURE,
+    LEVERAGE_LIMIT,
+    FORCED_LIQUIDATION,
+    VIX_HALT,
+    MARKET_CLOSED,
+    COMPLEX_PRODUCT_ACCREDITATION,
+    HFT_RESTRICTED,
+    INTERNATIONAL_EXPERIENCE,
+    CRYPTO_JURISDICTION,
+    RETAIL_VENUE_SIZE,
+    DAILY_LOSS_LIMIT,
+    MARKET_HALTED,
+};
+
+enum WarningFlag : uint16_t {
+    WARN_PATTERN_DAY_TRADER = 1 << 0,
+    WARN_SECTOR_CHECK_PENDING = 1 << 1,
+    WARN_PORTFOLIO_LOSS = 1 << 2,
+    WARN_POSITION_CONCENTRATION = 1 << 3,
+    WARN_MARGIN_CALL = 1 << 4,
+    WARN_PRE_MARKET = 1 << 5,
+    WARN_DARK_POOL_ROUTING = 1 << 6,
+    WARN_PRICE_IMPACT = 1 << 7,
+    WARN_DAILY_LOSS_APPROACHING = 1 << 8,
+    WARN_DAILY_LOSS_75_CROSSED = 1 << 9,     // once per trader per day
+    WARN_DAILY_LOSS_LIMIT_CROSSED = 1 << 10,  // once per trader per day
+};
+
+struct RiskDecision {
+    bool accepted;
+    RejectReason reason;
+    uint16_t warnings;
+
+    static RiskDecision accept(uint16_t warnings) {
+        return RiskDecision{true, RejectReason::NONE, warnings};
+    }
+    static RiskDecision reject(RejectReason reason, uint16_t warnings) {
+        return RiskDecision{false, reason, warnings};
+    }
+
+    explicit operator bool() const { return accepted; }
+};
+
+const char* describeRejectReason(RejectReason reason) {
+    switch (reason) {
+        case RejectReason::NONE: return "ACCEPTED";
+        case RejectReason::INSUFFICIENT_EXPERIENCE: return "REJECTED: Trader lacks minimum experience";
+        case RejectReason::INSUFFICIENT_BALANCE: return "REJECTED: Insufficient account balance";
+        case RejectReason::RESTRICTED_JURISDICTION: return "REJECTED: Trader from restricted jurisdiction";
+        case RejectReason::ACCREDITATION_REQUIRED: return "REJECTED: High-risk trading requires accreditation";
+        case RejectReason::FIRM_KILL_SWITCH: return "TRADING HALT: Firm-wide kill switch engaged";
+        case RejectReason::TRADER_SUSPENDED: return "REJECTED: Trader suspended by kill switch";
+        case RejectReason::ORDER_SIZE_LIMIT: return "REJECTED: Order size exceeds maximum allowed";
+        case RejectReason::VOLATILITY_RESTRICTED: return "REJECTED: High volatility instrument not allowed for low-risk trader";
+        case RejectReason::RETAIL_SHORT_LIMIT: return "REJECTED: Large short positions restricted for retail traders";
+        case RejectReason::INSUFFICIENT_MARGIN: return "REJECTED: Insufficient margin for trade";
+        case RejectReason::DAILY_TRADE_LIMIT: return "REJECTED: Daily trade limit exceeded";
+        case RejectReason::AFTER_HOURS_EXPERIENCE: return "REJECTED: Insufficient experience for after-hours trading";
+        case RejectReason::POSITION_SIZE_LIMIT: return "VIOLATION: Position size exceeds maximum allowed";
+        case RejectReason::HIGH_RISK_EXPOSURE: return "VIOLATION: High-risk exposure exceeds threshold";
+        case RejectReason::LEVERAGE_LIMIT: return "VIOLATION: Leverage ratio exceeds maximum allowed";
+        case RejectReason::FORCED_LIQUIDATION: return "FORCED LIQUIDATION: Account below liquidation threshold";
+        case RejectReason::VIX_HALT: return "TRADING HALT: Market volatility too high (VIX > 40)";
+        case RejectReason::MARKET_CLOSED: return "REJECTED: Market is closed for regular trading";
+        case RejectReason::COMPLEX_PRODUCT_ACCREDITATION: return "REJECTED: Complex products require accredited investor status";
+        case RejectReason::HFT_RESTRICTED: return "REJECTED: HFT algorithms restricted to proprietary traders";
+        case RejectReason::INTERNATIONAL_EXPERIENCE: return "REJECTED: International trading requires 5+ years experience";
+        case RejectReason::CRYPTO_JURISDICTION: return "REJECTED: Cryptocurrency trading not allowed in jurisdiction";
+        case RejectReason::RETAIL_VENUE_SIZE: return "REJECTED: Order too large for retail venue";
+        case RejectReason::DAILY_LOSS_LIMIT: return "TRADING SUSPENDED: Daily loss limit exceeded";
+        case RejectReason::TRADER_CAPACITY_EXCEEDED: return "REJECTED: Trader not logged in or state capacity exhausted";
+        case RejectReason::MARKET_HALTED: return "TRADING HALT: Market-wide halt in effect";
+    }
+    return "REJECTED: Unknown reason";
+}
+
+const char* describeWarning(WarningFlag warning) {
+    switch (warning) {
+        case WARN_PATTERN_DAY_TRADER: return "WARNING: Pattern Day Trader restrictions apply";
+        case WARN_SECTOR_CHECK_PENDING: return "INFO: Checking sector concentration limits";
+        case WARN_PORTFOLIO_LOSS: return "WARNING: Portfolio losses exceed 20% of account balance";
+        case WARN_POSITION_CONCENTRATION: return "WARNING: Single position exceeds 20% of portfolio";
+        case WARN_MARGIN_CALL: return "MARGIN CALL: Account below margin maintenance requirement";
+        case WARN_PRE_MARKET: return "RESTRICTED: Limited pre-market trading allowed";
+        case WARN_DARK_POOL_ROUTING: return "WARNING: Large orders should use dark pools";
+        case WARN_PRICE_IMPACT: return "WARNING: Large market orders may have price impact";
+        case WARN_DAILY_LOSS_APPROACHING: return "WARNING: Approaching daily loss limit";
+        case WARN_DAILY_LOSS_75_CROSSED: return "EVENT: Daily loss crossed 75% of limit";
+        case WARN_DAILY_LOSS_LIMIT_CROSSED: return "EVENT: Daily loss limit crossed";
+    }
+    return "WARNING: Unknown warning";
+}
+
+// Full-violation mode reports every rule at once as a 64-bit mask: bit n of
+// the low half is RejectReason n, the high half holds the WarningFlag bits.
+// RejectReason values follow each validator's rule order, so the lowest
+// violation bit is the reason first-failure mode would have returned.
+static_assert(static_cast<unsigned>(RejectReason::MARKET_HALTED) < 32,
+              "reasons must fit the low half");
+
+constexpr uint64_t ruleBit(RejectReason reason) {
+    return 1ull << static_cast<unsigned>(reason);
+}
+
+inline uint64_t warningBits(uint16_t warnings) {
+    return static_cast<uint64_t>(warnings) << 32;
+}
+
+// Branch-free helpers: the bit when cond holds, 0 otherwise
+inline uint64_t ruleIf(bool cond, RejectReason reason) {
+    return static_cast<uint64_t>(cond) << static_cast<unsigned>(reason);
+}
+
+inline uint64_t warningIf(bool cond, WarningFlag warning) {
+    return static_cast<uint64_t>(cond) * warningBits(warning);
+}
+
+inline RejectReason firstViolation(uint64_t rule_mask) {
+    uint32_t violations = static_cast<uint32_t>(rule_mask);
+    return violations != 0 ? static_cast<RejectReason>(__builtin_ctz(violations)) : RejectReason::NONE;
+}
+
+// firstViolation without the branch: bit 31 stands for "no violation"
+// and maps to NONE
+inline RejectReason firstViolationBranchless(uint32_t violations) {
+    uint32_t first = __builtin_ctz(violations | (1u << 31));
+    return static_cast<RejectReason>(first & ((first == 31) - 1u));
+}
+
+// Order rule bits decided before the daily trade limit; the rest of the
+// order rules are only reached by an order holding a trade slot
+constexpr uint32_t kAheadOfDailyLimit = static_cast<uint32_t>(ruleBit(RejectReason::DAILY_TRADE_LIMIT)) - 1;
+
+// Order rule bits that reject every order from the trader: the kill
+// switches and a missing state slot
+constexpr uint32_t kTraderRejectRules = static_cast<uint32_t>(ruleBit(RejectReason::FIRM_KILL_SWITCH) |
+                                                              ruleBit(RejectReason::TRADER_SUSPENDED) |
+                                                              ruleBit(RejectReason::TRADER_CAPACITY_EXCEEDED));
+
+constexpr uint32_t kAfterHoursRule = static_cast<uint32_t>(ruleBit(RejectReason::AFTER_HOURS_EXPERIENCE));
+
+// Portfolio rule bits decided before the margin call assessment, so a
+// rejection for one of them carries no WARN_MARGIN_CALL
+constexpr uint32_t kAheadOfMarginCall = static_cast<uint32_t>(ruleBit(RejectReason::POSITION_SIZE_LIMIT) |
+                                                              ruleBit(RejectReason::HIGH_RISK_EXPOSURE) |
+                                                              ruleBit(RejectReason::LEVERAGE_LIMIT));
+
+// Renders warnings (in flag order) followed by the rejection, if any
+void printRiskDecision(std::ostream& out, const RiskDecision& decision) {
+    for (uint16_t bit = 1; bit != 0 && bit <= decision.warnings; bit <<= 1) {
+        if (decision.warnings & bit) {
+            out << describeWarning(static_cast<WarningFlag>(bit)) << '\n';
+        }
+    }
+    if (!decision.accepted) {
+        out << describeRejectReason(decision.reason) << '\n';
+    }
+}
+
+// The trader half of the stateless order rules (see orderRuleTrader): the
+// rule bits an order from this trader can trip, and the notional from
+// which a margin order exceeds the trader's margin. Gathered once per trader.
+struct OrderRuleTrader {
+    uint32_t rules;
+    int64_t margin_floor;
+};
+
+// The order-side limits of the stateless order rules, from one snapshot
+struct OrderRuleLimits {
+    int64_t max_order_size;
+    double low_risk_max_volatility;
+    int64_t retail_short_limit;
+    int max_trades_per_day;
+};
+
+// Output of validateTradeOrderBatch. Buffers are reused across batches, so
+// a steady stream of same-sized batches does not allocate.
+struct BatchDecisions {
+    std::vector<uint64_t> accepted;     // bit i of word i / 64: order i accepted
+    std::vector<RejectReason> reasons;  // NONE for accepted orders
+
+    // Scratch for the validator, one array per field so the kernels can
+    // gather them. Per order: the trader index, clamped to the reject-all
+    // row past the table, violation bits and the order's place among its
+    // trader's slot requests. Per trader, plus that row: OrderRuleTrader
+    // plus kTraderRejectRules, and the slot reservation.
+    std::vector<uint32_t> trader;
+    std::vector<uint32_t> violations;
+    std::vector<int> ordinal;
+    std::vector<uint32_t> trader_rules;
+    std::vector<int64_t> margin_floor;
+    std::vector<uint32_t> slot;
+    std::vector<int> wanted;   // slot reservations requested in this batch
+    std::vector<int> granted;
+    std::vector<int> base;     // trade count before this batch
+
+    void prepare(size_t orders, size_t trader_count) {
+        accepted.assign((orders + 63) / 64, 0);
+        reasons.resize(orders);
+        trader.resize(orders);
+        violations.resize(orders);
+        ordinal.resize(orders);
+        trader_rules.resize(trader_count + 1);
+        margin_floor.resize(trader_count + 1);
+        slot.resize(trader_count + 1);
+        wanted.assign(trader_count + 1, 0);
+        granted.assign(trader_count + 1, 0);
+        base.assign(trader_count + 1, 0);
+    }
+
+    bool isAccepted(size_t i) const { return (accepted[i / 64] >> (i % 64)) & 1; }
+};
+
+// Order rule bits that keep an order out of its trader's slot reservation.
+// Extended-hours orders that fail only on experience reserve and release a
+// slot in validateTradeOrder, so they do not count towards it either.
+constexpr uint32_t kNotReserving = kAheadOfDailyLimit | kAfterHoursRule;
+
+// Numbers order i among its trader's slot requests, in batch order; pass 1
+// calls it as soon as the order's violation bits are known
+inline void numberBatchOrder(BatchDecisions& out, size_t i) {
+    int& wanted = out.wanted[out.trader[i]];
+    out.ordinal[i] = wanted;
+    wanted += (out.violations[i] & kNotReserving) == 0;
+}
+
+// Pass 2 of validateTradeOrderBatch: each order's reason from its violation
+// bits and its trader's reservation, selecting with conditional moves
+// rather than branching on each order's outcome. Extended-hours orders did
+// not count towards the reservation; they are over the limit if the trader
+// was already full when they would have taken their slot.
+inline void resolveOrderBatchScalar(size_t begin, size_t count, int limit, BatchDecisions& out) {
+    for (size_t i = begin; i < count; ++i) {
+        const uint32_t t = out.trader[i];
+        const uint32_t violations = out.violations[i];
+        const int ordinal = out.ordinal[i];
+        const int granted = out.granted[t];
+        RejectReason first = firstViolationBranchless(violations & kAheadOfDailyLimit);
+        uint32_t pending = first == RejectReason::NONE;
+        uint32_t extended_hours = (violations & kAfterHoursRule) != 0;
+        uint32_t over_limit = (extended_hours & (out.base[t] + std::min(ordinal, granted) >= limit)) |
+                              ((extended_hours ^ 1) & (ordinal >= granted));
+        uint32_t resolved = over_limit * static_cast<uint32_t>(RejectReason::DAILY_TRADE_LIMIT) +
+                            ((over_limit ^ 1) & extended_hours) *
+                                static_cast<uint32_t>(RejectReason::AFTER_HOURS_EXPERIENCE);
+        uint32_t reason = static_cast<uint32_t>(first) | pending * resolved;
+        out.reasons[i] = static_cast<RejectReason>(reason);
+        out.accepted[i / 64] |= static_cast<uint64_t>(reason == 0) << (i % 64);
+    }
+}
+
+// The batch kernels. Pass 1 clamps the trader column to reject_row, the
+// reject-all row past the table, so no gather leaves the trader arrays and
+// the indices stay within the signed 32-bit range the gathers take. It
+// compares the order columns against the order-side limits into one lane
+// mask per rule, turns the masks into rule bits and keeps those the trader
+// is subject to, then numbers the orders as numberBatchOrder does. It
+// returns how many orders it covered and leaves the rest to orderRuleMask.
+// Pass 2 is resolveOrderBatchScalar across lanes, with the first violation
+// read from the float exponent of its isolated low bit.
+#if defined(__x86_64__) || defined(__i386__)
+// Bit i set where bytes[i] == value, for 8 consecutive one-byte codes
+template <typename Code>
+__attribute__((target("avx2")))
+inline unsigned matchCodes8(const std::vector<Code>& codes, size_t i, Code value) {
+    const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&codes[i]));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(value)))) & 0xFF;
+}
+
+// Rule bits where mask bit n is set, as 64-bit lanes n = 0..3
+__attribute__((target("avx2")))
+inline __m256i ruleLanes4(unsigned mask, RejectReason reason) {
+    const __m256i lane_bits = _mm256_setr_epi64x(1, 2, 4, 8);
+    const __m256i selected = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(mask), lane_bits), lane_bits);
+    return _mm256_and_si256(selected, _mm256_set1_epi64x(static_cast<int64_t>(ruleBit(reason))));
+}
+
+__attribute__((target("avx2")))
+size_t orderRuleViolationsAvx2(const OrderColumns& orders, const OrderRuleLimits& lim, uint32_t reject_row,
+                               BatchDecisions& out) {
+    const size_t count = orders.size();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const unsigned short_sale = matchCodes8(orders.type, i, OrderType::SHORT);
+        const unsigned extended_hours = matchCodes8(orders.tif, i, TimeInForce::EXTENDED_HOURS);
+        const unsigned margin = matchCodes8(orders.margin, i, uint8_t{0}) ^ 0xFF;
+        for (size_t half = 0; half < 8; half += 4) {
+            const __m128i trader =
+                _mm_min_epu32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&orders.trader[i + half])),
+                              _mm_set1_epi32(static_cast<int>(reject_row)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.trader[i + half]), trader);
+            const __m256i notional =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&orders.notional[i + half]));
+            const __m256d volatility = _mm256_loadu_pd(&orders.volatility[i + half]);
+            const __m256i margin_floor = _mm256_i32gather_epi64(
+                reinterpret_cast<const long long*>(out.margin_floor.data()), trader, 8);
+
+            const unsigned oversized = _mm256_movemask_pd(_mm256_castsi256_pd(
+                _mm256_cmpgt_epi64(notional, _mm256_set1_epi64x(lim.max_order_size))));
+            const unsigned volatile_order = _mm256_movemask_pd(
+                _mm256_cmp_pd(volatility, _mm256_set1_pd(lim.low_risk_max_volatility), _CMP_GT_OQ));
+            const unsigned large_short = _mm256_movemask_pd(_mm256_castsi256_pd(
+                _mm256_cmpgt_epi64(notional, _mm256_set1_epi64x(lim.retail_short_limit))));
+            const unsigned below_floor =
+                _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(margin_floor, notional)));
+
+            __m256i rules = ruleLanes4(oversized, RejectReason::ORDER_SIZE_LIMIT);
+            rules = _mm256_or_si256(rules, ruleLanes4(volatile_order, RejectReason::VOLATILITY_RESTRICTED));
+            rules = _mm256_or_si256(rules, ruleLanes4(large_short & (short_sale >> half),
+                                                      RejectReason::RETAIL_SHORT_LIMIT));
+            rules = _mm256_or_si256(rules, ruleLanes4(~below_floor & (margin >> half),
+                                                      RejectReason::INSUFFICIENT_MARGIN));
+            rules = _mm256_or_si256(rules, ruleLanes4(extended_hours >> half,
+                                                      RejectReason::AFTER_HOURS_EXPERIENCE));
+            // Low halves of the four 64-bit lanes
+            const __m128i order_rules = _mm256_castsi256_si128(
+                _mm256_permutevar8x32_epi32(rules, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+            const __m128i trader_rules =
+                _mm_i32gather_epi32(reinterpret_cast<const int*>(out.trader_rules.data()), trader, 4);
+            const __m128i violations = _mm_and_si128(
+                _mm_or_si128(order_rules, _mm_set1_epi32(static_cast<int>(kTraderRejectRules))), trader_rules);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.violations[i + half]), violations);
+        }
+        // Without conflict detection the numbering stays scalar, on lines
+        // still in L1
+        for (size_t k = i; k < i + 8; ++k) {
+            numberBatchOrder(out, k);
+        }
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+void resolveOrderBatchAvx2(size_t count, int limit, BatchDecisions& out) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i after_hours = _mm256_set1_epi32(static_cast<int>(kAfterHoursRule));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i trader = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&out.trader[i]));
+        const __m256i violations = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&out.violations[i]));
+        const __m256i ordinal = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&out.ordinal[i]));
+        const __m256i granted = _mm256_i32gather_epi32(out.granted.data(), trader, 4);
+        const __m256i base = _mm256_i32gather_epi32(out.base.data(), trader, 4);
+
+        const __m256i ahead = _mm256_and_si256(violations, _mm256_set1_epi32(static_cast<int>(kAheadOfDailyLimit)));
+        const __m256i lowest = _mm256_and_si256(ahead, _mm256_sub_epi32(zero, ahead));
+        const __m256i first = _mm256_sub_epi32(
+            _mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(lowest)), 23), _mm256_set1_epi32(127));
+        const __m256i pending = _mm256_cmpeq_epi32(ahead, zero);
+        const __m256i extended_hours = _mm256_cmpeq_epi32(_mm256_and_si256(violations, after_hours), after_hours);
+
+        // a >= b as the complement of b > a
+        const __m256i ones = _mm256_cmpeq_epi32(zero, zero);
+        const __m256i full_before = _mm256_xor_si256(ones, _mm256_cmpgt_epi32(
+            _mm256_set1_epi32(limit), _mm256_add_epi32(base, _mm256_min_epi32(ordinal, granted))));
+        const __m256i beyond_grant = _mm256_xor_si256(ones, _mm256_cmpgt_epi32(granted, ordinal));
+        const __m256i over_limit = _mm256_blendv_epi8(beyond_grant, full_before, extended_hours);
+        const __m256i daily_limit = _mm256_set1_epi32(static_cast<int>(RejectReason::DAILY_TRADE_LIMIT));
+        const __m256i experience = _mm256_set1_epi32(static_cast<int>(RejectReason::AFTER_HOURS_EXPERIENCE));
+        const __m256i resolved = _mm256_or_si256(_mm256_and_si256(over_limit, daily_limit),
+                                                 _mm256_andnot_si256(over_limit, _mm256_and_si256(extended_hours,
+                                                                                                  experience)));
+        const __m256i reason = _mm256_blendv_epi8(first, resolved, pending);
+
+        // Low byte of each lane; the two 128-bit halves pack separately
+        const __m256i bytes = _mm256_packus_epi16(_mm256_packus_epi32(reason, reason), zero);
+        const uint32_t low = static_cast<uint32_t>(_mm256_cvtsi256_si32(bytes));
+        const uint32_t high = static_cast<uint32_t>(_mm256_extract_epi32(bytes, 4));
+        std::memcpy(&out.reasons[i], &low, sizeof(low));
+        std::memcpy(&out.reasons[i + 4], &high, sizeof(high));
+        const unsigned accepted = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(reason, zero)));
+        out.accepted[i / 64] |= static_cast<uint64_t>(accepted) << (i % 64);
+    }
+    resolveOrderBatchScalar(i, count, limit, out);
+}
+
+__attribute__((target("avx512f")))
+inline __m512i broadcastRule8(RejectReason reason) {
+    return _mm512_set1_epi64(static_cast<int64_t>(ruleBit(reason)));
+}
+
+// Set bits per 32-bit lane, for lanes below 256
+__attribute__((target("avx2")))
+inline __m256i popcountLow8(__m256i bits) {
+    const __m256i nibble_counts = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_and_si256(bits, _mm256_set1_epi32(0x0F));
+    const __m256i high = _mm256_srli_epi32(bits, 4);
+    return _mm256_add_epi32(_mm256_shuffle_epi8(nibble_counts, low), _mm256_shuffle_epi8(nibble_counts, high));
+}
+
+__attribute__((target("avx512f,avx512vl,avx512cd")))
+size_t orderRuleViolationsAvx512(const OrderColumns& orders, const OrderRuleLimits& lim, uint32_t reject_row,
+                                 BatchDecisions& out) {
+    const size_t count = orders.size();
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i trader =
+            _mm256_min_epu32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&orders.trader[i])),
+                             _mm256_set1_epi32(static_cast<int>(reject_row)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.trader[i]), trader);
+        const __m512i notional = _mm512_loadu_si512(&orders.notional[i]);
+        const __m512d volatility = _mm512_loadu_pd(&orders.volatility[i]);
+        // Masked forms: the plain ones trip -Wmaybe-uninitialized on GCC 12
+        const __m512i margin_floor =
+            _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), 0xFF, trader, out.margin_floor.data(), 8);
+
+        const __mmask8 oversized = _mm512_cmpgt_epi64_mask(notional, _mm512_set1_epi64(lim.max_order_size));
+        const __mmask8 volatile_order =
+            _mm512_cmp_pd_mask(volatility, _mm512_set1_pd(lim.low_risk_max_volatility), _CMP_GT_OQ);
+        const __mmask8 large_short =
+            _mm512_mask_cmpgt_epi64_mask(static_cast<__mmask8>(matchCodes8(orders.type, i, OrderType::SHORT)),
+                                         notional, _mm512_set1_epi64(lim.retail_short_limit));
+        const __mmask8 over_margin = _mm512_mask_cmpge_epi64_mask(
+            static_cast<__mmask8>(matchCodes8(orders.margin, i, uint8_t{0}) ^ 0xFF), notional, margin_floor);
+        const __mmask8 extended_hours =
+            static_cast<__mmask8>(matchCodes8(orders.tif, i, TimeInForce::EXTENDED_HOURS));
+
+        __m512i rules = _mm512_maskz_mov_epi64(oversized, broadcastRule8(RejectReason::ORDER_SIZE_LIMIT));
+        rules = _mm512_mask_mov_epi64(rules, volatile_order,
+                                      _mm512_or_si512(rules, broadcastRule8(RejectReason::VOLATILITY_RESTRICTED)));
+        rules = _mm512_mask_mov_epi64(rules, large_short,
+                                      _mm512_or_si512(rules, broadcastRule8(RejectReason::RETAIL_SHORT_LIMIT)));
+        rules = _mm512_mask_mov_epi64(rules, over_margin,
+                                      _mm512_or_si512(rules, broadcastRule8(RejectReason::INSUFFICIENT_MARGIN)));
+        rules = _mm512_mask_mov_epi64(rules, extended_hours,
+                                      _mm512_or_si512(rules, broadcastRule8(RejectReason::AFTER_HOURS_EXPERIENCE)));
+        const __m256i order_rules = _mm512_maskz_cvtepi64_epi32(0xFF, rules);
+        const __m256i trader_rules =
+            _mm256_i32gather_epi32(reinterpret_cast<const int*>(out.trader_rules.data()), trader, 4);
+        const __m256i violations = _mm256_and_si256(
+            _mm256_or_si256(order_rules, _mm256_set1_epi32(static_cast<int>(kTraderRejectRules))), trader_rules);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.violations[i]), violations);
+
+        // Numbering as a histogram: an order's ordinal is its trader's count
+        // so far plus the reserving orders ahead of it in these lanes, which
+        // conflict detection finds. The scatter writes lanes in order, so
+        // each trader's last lane leaves its running count.
+        const __mmask8 reserving =
+            _mm256_testn_epi32_mask(violations, _mm256_set1_epi32(static_cast<int>(kNotReserving)));
+        const __m256i ahead = _mm256_and_si256(_mm256_conflict_epi32(trader), _mm256_set1_epi32(reserving));
+        const __m256i wanted = _mm256_mmask_i32gather_epi32(zero, 0xFF, trader, out.wanted.data(), 4);
+        const __m256i ordinal = _mm256_add_epi32(wanted, popcountLow8(ahead));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.ordinal[i]), ordinal);
+        _mm256_i32scatter_epi32(out.wanted.data(), trader,
+                                _mm256_mask_add_epi32(ordinal, reserving, ordinal, _mm256_set1_epi32(1)), 4);
+    }
+    return i;
+}
+
+__attribute__((target("avx512f")))
+void resolveOrderBatchAvx512(size_t count, int limit, BatchDecisions& out) {
+    const __m512i zero = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512i trader = _mm512_loadu_si512(&out.trader[i]);
+        const __m512i violations = _mm512_loadu_si512(&out.violations[i]);
+        const __m512i ordinal = _mm512_loadu_si512(&out.ordinal[i]);
+        // Masked forms throughout: the plain ones trip -Wmaybe-uninitialized on GCC 12
+        const __m512i granted = _mm512_mask_i32gather_epi32(zero, 0xFFFF, trader, out.granted.data(), 4);
+        const __m512i base = _mm512_mask_i32gather_epi32(zero, 0xFFFF, trader, out.base.data(), 4);
+
+        const __m512i ahead = _mm512_and_si512(violations, _mm512_set1_epi32(static_cast<int>(kAheadOfDailyLimit)));
+        const __m512i lowest = _mm512_and_si512(ahead, _mm512_sub_epi32(zero, ahead));
+        const __m512i exponent =
+            _mm512_maskz_srli_epi32(0xFFFF, _mm512_castps_si512(_mm512_maskz_cvtepi32_ps(0xFFFF, lowest)), 23);
+        const __m512i first = _mm512_sub_epi32(exponent, _mm512_set1_epi32(127));
+        const __mmask16 pending = _mm512_testn_epi32_mask(ahead, ahead);
+        const __mmask16 extended_hours =
+            _mm512_test_epi32_mask(violations, _mm512_set1_epi32(static_cast<int>(kAfterHoursRule)));
+
+        const __m512i slot_before = _mm512_add_epi32(base, _mm512_maskz_min_epi32(0xFFFF, ordinal, granted));
+        const __mmask16 over_limit =
+            (extended_hours & _mm512_cmpge_epi32_mask(slot_before, _mm512_set1_epi32(limit))) |
+            (~extended_hours & _mm512_cmpge_epi32_mask(ordinal, granted));
+        __m512i resolved =
+            _mm512_maskz_mov_epi32(over_limit, _mm512_set1_epi32(static_cast<int>(RejectReason::DAILY_TRADE_LIMIT)));
+        resolved = _mm512_mask_mov_epi32(resolved, extended_hours & ~over_limit,
+                                         _mm512_set1_epi32(static_cast<int>(RejectReason::AFTER_HOURS_EXPERIENCE)));
+        const __m512i reason = _mm512_mask_blend_epi32(pending, first, resolved);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.reasons[i]), _mm512_maskz_cvtepi32_epi8(0xFFFF, reason));
+        const __mmask16 accepted = _mm512_testn_epi32_mask(reason, reason);
+        out.accepted[i / 64] |= static_cast<uint64_t>(accepted) << (i % 64);
+    }
+    resolveOrderBatchScalar(i, count, limit, out);
+}
+#endif
+
+// Per-trader daily counters, kept together so one slot is one lookup. All
+// are lock-free: trade_count counts reserved plus filled trades,
+// daily_loss_raw is a Fixed amount, and loss_events latches the loss
+// threshold crossings already reported today. suspended is the trader's
+// kill switch; it survives the daily reset until lifted explicitly.
+// Padded to a cache line: SHARED callers on different cores update
+// neighbouring traders, and 24 packed bytes would put two or three of them
+// on one line and bounce it between the cores.
+struct alignas(64) TraderDailyState {
+    std::atomic<int> trade_count;
+    std::atomic<int> trades_filled;
+    std::atomic<int64_t> daily_loss_raw;
+    std::atomic<uint8_t> loss_events;
+    std::atomic<uint8_t> suspended;
+};
+static_assert(sizeof(TraderDailyState) == 64, "TraderDailyState must fill exactly one cache line");
+
+enum LossEventLatch : uint8_t {
+    LOSS_WARNING_REPORTED = 1 << 0,
+    LOSS_LIMIT_REPORTED = 1 << 1,
+};
+
+// How a call may touch TraderDailyState. SHARED callers can race on the
+// same trader and update it with atomic read-modify-writes. An OWNER caller
+// is the only thread touching the trader's shard (see ShardPipeline), so
+// updates are plain relaxed loads and stores: no locked instructions, no
+// fences, no retry loops.
+enum class StateAccess { SHARED, OWNER };
+
+// Which form of the order and eligibility rules a manager runs. BRANCHING
+// is the rule-by-rule if chain. BRANCHLESS evaluates every predicate into
+// a mask and picks the reason arithmetically, which pays off when
+// rejections are too irregular for the branch predictor. Both decide
+// identically.
+enum class RuleKernel : unsigned char { BRANCHING, BRANCHLESS };
+
+// NUMA placement of per-trader state. With libnuma, arrays are bound to an
+// explicit node and threads can be bound to run there. Without it (or on a
+// single-node host) placement relies on first touch: the kernel backs each
+// page on the node of the thread that first writes it, so an array zeroed
+// by its owning thread lives on that thread's node.
+inline int numaNodeCount() {
+#ifdef RISK_WITH_LIBNUMA
+    if (numa_available() >= 0) {
+        return numa_num_configured_nodes();
+    }
+#endif
+    return 1;
+}
+
+// Keeps the calling thread on node's CPUs; a no-op without libnuma
+inline void runOnNumaNode(int node) {
+#ifdef RISK_WITH_LIBNUMA
+    if (numa_available() >= 0 && node >= 0) {
+        numa_run_on_node(node);
+    }
+#else
+    (void)node;
+#endif
+}
+
+// Array of zeroed TraderDailyState on node, or first-touched by the calling
+// thread when node is -1 or explicit binding is unavailable
+class StateArray {
+private:
+    TraderDailyState* states = nullptr;
+    size_t bytes = 0;
+    bool numa_allocated = false;
+
+    void release() {
+#ifdef RISK_WITH_LIBNUMA
+        if (numa_allocated) {
+            numa_free(states, bytes);
+            return;
+        }
+#endif
+        ::operator delete(states, std::align_val_t{alignof(TraderDailyState)});
+    }
+
+public:
+    StateArray() = default;
+    StateArray(size_t count, int node) : bytes(count * sizeof(TraderDailyState)) {
+#ifdef RISK_WITH_LIBNUMA
+        if (node >= 0 && numa_available() >= 0) {
+            states = static_cast<TraderDailyState*>(numa_alloc_onnode(bytes, node));
+            numa_allocated = states != nullptr;
+        }
+#else
+        (void)node;
+#endif
+        if (states == nullptr) {
+            states = static_cast<TraderDailyState*>(
+                ::operator new(bytes, std::align_val_t{alignof(TraderDailyState)}));
+        }
+        for (size_t i = 0; i < count; ++i) {
+            new (&states[i]) TraderDailyState();
+        }
+    }
+    StateArray(const StateArray&) = delete;
+    StateArray& operator=(const StateArray&) = delete;
+    StateArray& operator=(StateArray&& other) noexcept {
+        std::swap(states, other.states);
+        std::swap(bytes, other.bytes);
+        std::swap(numa_allocated, other.numa_allocated);
+        return *this;
+    }
+    ~StateArray() {
+        if (states != nullptr) {
+            release();
+        }
+    }
+
+    TraderDailyState& operator[](size_t index) { return states[index]; }
+};
+
+// Per-trader state, sharded by trader_id so concurrent callers only contend
+// within a shard. A trader is mapped to a slot once, at login; the slot
+// encodes its shard (low bits) and its index in that shard's dense array.
+// Each shard's array is allocated once at construction and never moves,
+// so logins never reallocate and no access allocates.
+class TraderStateTable {
+private:
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<int, uint32_t> slot_of;
+        StateArray states;
+        uint32_t used = 0;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    uint32_t shard_bits;
+    uint32_t shard_capacity;
+    uint32_t table_id;
+
+    static uint32_t nextTableId() {
+        static std::atomic<uint32_t> next_id{1};
+        return next_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Walks the shards from the trader's own, one lock at a time
+    uint32_t probe(int trader_id, bool assign) {
+        const uint32_t shard_count = 1u << shard_bits;
+        const uint32_t home = shardOf(trader_id);
+        for (uint32_t step = 0; step < shard_count; ++step) {
+            const uint32_t shard_index = (home + step) & (shard_count - 1);
+            Shard& shard = shards[shard_index];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.slot_of.find(trader_id);
+            if (it != shard.slot_of.end()) {
+                return it->second;
+            }
+            if (shard.used < shard_capacity) {
+                if (!assign) {
+                    return INVALID_SLOT;
+                }
+                uint32_t slot = (shard.used++ << shard_bits) | shard_index;
+                shard.slot_of.emplace(trader_id, slot);
+                return slot;
+            }
+        }
+        return INVALID_SLOT;
+    }
+
+public:
+    static const uint32_t INVALID_SLOT = 0xFFFFFFFFu;
+
+    // shard_count is rounded up to a power of two. Each shard holds
+    // capacity / shard_count traders plus 25% headroom for hash imbalance;
+    // a trader whose shard is full spills to the next shard with room, so
+    // the table always takes capacity traders however the ids hash.
+    explicit TraderStateTable(size_t capacity, uint32_t shard_count = 64) : shard_bits(0), table_id(nextTableId()) {
+        while ((1u << shard_bits) < shard_count) {
+            ++shard_bits;
+        }
+        shard_count = 1u << shard_bits;
+        shard_capacity = static_cast<uint32_t>((capacity + shard_count - 1) / shard_count);
+        shard_capacity += shard_capacity / 4 + 1;
+        shards.reset(new Shard[shard_count]);
+        for (uint32_t i = 0; i < shard_count; ++i) {
+            shards[i].slot_of.reserve(shard_capacity);
+            shards[i].states = StateArray(shard_capacity, -1);
+        }
+    }
+
+    uint32_t shardCount() const { return 1u << shard_bits; }
+
+    // Unique per table (never 0), so a slot can be tagged with its table
+    uint32_t id() const { return table_id; }
+
+    uint32_t shardOf(int trader_id) const {
+        // Fibonacci hashing spreads sequential ids across shards
+        uint32_t h = static_cast<uint32_t>(trader_id) * 2654435769u;
+        return shard_bits == 0 ? 0 : h >> (32 - shard_bits);
+    }
+
+    uint32_t shardOfSlot(uint32_t slot) const { return slot & ((1u << shard_bits) - 1); }
+
+    // Returns INVALID_SLOT only if every shard is full. Slots are never
+    // freed, so the shards a trader spilled past stay full and lookups can
+    // follow the same probe sequence, stopping at the first shard with room.
+    uint32_t assignSlot(int trader_id) {
+        return probe(trader_id, true);
+    }
+
+    uint32_t findSlot(int trader_id) {
+        return probe(trader_id, false);
+    }
+
+    // The state itself is lock-free; the shard mutex only guards slot
+    // assignment
+    TraderDailyState& operator[](uint32_t slot) {
+        assert((slot >> shard_bits) < shard_capacity && "slot from another TraderStateTable");
+        return shards[shardOfSlot(slot)].states[slot >> shard_bits];
+    }
+
+    // Moves the shard's state onto node (-1: the calling thread's node, by
+    // first touch), carrying over current values. Call from the thread that
+    // will own the shard, before it validates; not meant to overlap with
+    // validations.
+    void placeShard(uint32_t shard_index, int node) {
+        Shard& shard = shards[shard_index];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        StateArray placed(shard_capacity, node);
+        for (uint32_t j = 0; j < shard.used; ++j) {
+            TraderDailyState& from = shard.states[j];
+            TraderDailyState& to = placed[j];
+            to.trade_count.store(from.trade_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            to.trades_filled.store(from.trades_filled.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            to.daily_loss_raw.store(from.daily_loss_raw.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            to.loss_events.store(from.loss_events.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            to.suspended.store(from.suspended.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        shard.states = std::move(placed);
+    }
+
+    // Start-of-day reset; not meant to overlap with validations
+    void resetDailyState() {
+        for (uint32_t i = 0; i < shardCount(); ++i) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            for (uint32_t j = 0; j < shards[i].used; ++j) {
+                TraderDailyState& state = shards[i].states[j];
+                state.trade_count.store(0, std::memory_order_relaxed);
+                state.trades_filled.store(0, std::memory_order_relaxed);
+                state.daily_loss_raw.store(0, std::memory_order_relaxed);
+                state.loss_events.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+// Market-wide halts declared by the exchange or regulator
+enum MarketHaltFlag : uint32_t {
+    HALT_CIRCUIT_BREAKER = 1u << 0,
+    HALT_REGULATORY = 1u << 1,
+};
+
+struct MarketConditions {
+    double vix;
+    MarketStatus status;
+    uint32_t halt_flags;
+};
+
+// Market conditions published by a single market-data thread and read by
+// any number of validator threads through a seqlock. Readers never write
+// shared memory, so they take no lock and cause no cache-line bouncing;
+// they retry only if a publish overlapped their read.
+class MarketConditionsSeqlock {
+private:
+    alignas(64) std::atomic<uint32_t> sequence{0};
+    std::atomic<uint64_t> vix_bits{0};
+    std::atomic<uint32_t> status{static_cast<uint32_t>(MarketStatus::UNKNOWN)};
+    std::atomic<uint32_t> halt_flags{0};
+
+public:
+    // Single writer; concurrent publishers must be serialized by the caller
+    void publish(const MarketConditions& conditions) {
+        uint64_t bits;
+        std::memcpy(&bits, &conditions.vix, sizeof(bits));
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        vix_bits.store(bits, std::memory_order_relaxed);
+        status.store(static_cast<uint32_t>(conditions.status), std::memory_order_relaxed);
+        halt_flags.store(conditions.halt_flags, std::memory_order_relaxed);
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    MarketConditions read() const {
+        MarketConditions snapshot;
+        uint32_t before, after;
+        do {
+            before = sequence.load(std::memory_order_acquire);
+            uint64_t bits = vix_bits.load(std::memory_order_relaxed);
+            std::memcpy(&snapshot.vix, &bits, sizeof(bits));
+            snapshot.status = static_cast<MarketStatus>(status.load(std::memory_order_relaxed));
+            snapshot.halt_flags = halt_flags.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+        return snapshot;
+    }
+};
+
+// Firm-wide and per-trader kill switches folded into one word: the top bit
+// is the firm-wide halt, the rest counts suspended traders. While nothing
+// is engaged, validators pay a single relaxed load of a line that is only
+// ever written when a switch flips; a flip invalidates that line in every
+// core's cache, so the next validation anywhere sees it.
+class KillSwitch {
+private:
+    static constexpr uint32_t FIRM_HALT = 1u << 31;
+
+    alignas(64) std::atomic<uint32_t> word{0};
+
+public:
+    bool anyEngaged() const { return word.load(std::memory_order_relaxed) != 0; }
+
+    bool firmHalted() const { return (word.load(std::memory_order_acquire) & FIRM_HALT) != 0; }
+
+    void haltFirm() { word.fetch_or(FIRM_HALT, std::memory_order_release); }
+
+    void resumeFirm() { word.fetch_and(~FIRM_HALT, std::memory_order_release); }
+
+    // Idempotent; true if this call suspended the trader
+    bool suspend(TraderDailyState& state) {
+        if (state.suspended.exchange(1, std::memory_order_relaxed) != 0) {
+            return false;
+        }
+        word.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    bool resume(TraderDailyState& state) {
+        if (state.suspended.exchange(0, std::memory_order_relaxed) == 0) {
+            return false;
+        }
+        word.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+};
+
+// Experience thresholds suitabilityRule() compares against, ascending.
+// SuitabilityMatrix buckets experience at exactly these years, so a rule
+// that tests experience against any other value must list it here.
+constexpr int INTERNATIONAL_MIN_EXPERIENCE = 5;
+constexpr int SUITABILITY_EXPERIENCE_YEARS[] = {INTERNATIONAL_MIN_EXPERIENCE};
+
+constexpr bool suitabilityThresholdsAscending() {
+    for (size_t i = 1; i < sizeof(SUITABILITY_EXPERIENCE_YEARS) / sizeof(SUITABILITY_EXPERIENCE_YEARS[0]); ++i) {
+        if (SUITABILITY_EXPERIENCE_YEARS[i - 1] >= SUITABILITY_EXPERIENCE_YEARS[i]) return false;
+    }
+    return true;
+}
+static_assert(suitabilityThresholdsAscending(), "SUITABILITY_EXPERIENCE_YEARS must be ascending");
+
+// Business Rule: Client suitability assessment. The reference form of the
+// rules; SuitabilityMatrix compiles it into a lookup table.
+RejectReason suitabilityRule(TraderType trader_type, bool is_accredited, int experience_years,
+                             Jurisdiction jurisdiction, ProductType product) {
+    // Business Rule: Complex products require institutional status
+    if (product == ProductType::DERIVATIVES || product == ProductType::STRUCTURED_PRODUCTS) {
+        if (trader_type == TraderType::RETAIL && !is_accredited) {
+            return RejectReason::COMPLEX_PRODUCT_ACCREDITATION;
+        }
+    }
+
+    // Business Rule: High-frequency trading restrictions
+    if (product == ProductType::HFT_ALGORITHMS) {
+        if (trader_type != TraderType::PROPRIETARY) {
+            return RejectReason::HFT_RESTRICTED;
+        }
+    }
+
+    // Business Rule: International trading requirements
+    if (product == ProductType::INTERNATIONAL_EQUITIES) {
+        if (experience_years < INTERNATIONAL_MIN_EXPERIENCE) {
+            return RejectReason::INTERNATIONAL_EXPERIENCE;
+        }
+    }
+
+    // Business Rule: Cryptocurrency trading restrictions
+    if (product == ProductType::CRYPTOCURRENCY) {
+        if (jurisdiction == Jurisdiction::NY || jurisdiction == Jurisdiction::RESTRICTED_CRYPTO) {
+            return RejectReason::CRYPTO_JURISDICTION;
+        }
+    }
+
+    return RejectReason::NONE;
+}
+
+// Client suitability compiled to one product bitmask per (trader type,
+// accreditation, experience bucket, jurisdiction), plus the rejection reason
+// for each product in that row. Experience is bucketed at the
+// SUITABILITY_EXPERIENCE_YEARS thresholds. Any rule change that keeps
+// experience to those thresholds and reads no other trader field is
+// picked up by rebuild().
+class SuitabilityMatrix {
+private:
+    static const int TRADER_TYPES = static_cast<int>(TraderType::PROPRIETARY) + 1;
+    static const int JURISDICTIONS = static_cast<int>(Jurisdiction::RESTRICTED_CRYPTO) + 1;
+    static const int PRODUCTS = static_cast<int>(ProductType::CRYPTOCURRENCY) + 1;
+    static const int EXPERIENCE_BUCKETS =
+        static_cast<int>(sizeof(SUITABILITY_EXPERIENCE_YEARS) / sizeof(SUITABILITY_EXPERIENCE_YEARS[0])) + 1;
+    static const int ROWS = TRADER_TYPES * 2 * EXPERIENCE_BUCKETS * JURISDICTIONS;
+
+    uint32_t permitted[ROWS];
+    RejectReason reasons[ROWS][PRODUCTS];
+
+    static int row(TraderType trader_type, bool is_accredited, int bucket, Jurisdiction jurisdiction) {
+        return ((static_cast<int>(trader_type) * 2 + is_accredited) * EXPERIENCE_BUCKETS + bucket) *
+                   JURISDICTIONS + static_cast<int>(jurisdiction);
+    }
+
+    static int experienceBucket(int experience_years) {
+        int bucket = 0;
+        for (int threshold : SUITABILITY_EXPERIENCE_YEARS) {
+            bucket += experience_years >= threshold;
+        }
+        return bucket;
+    }
+
+    // An experience value inside the bucket, to evaluate the rule with
+    static int bucketYears(int bucket) {
+        return bucket == 0 ? SUITABILITY_EXPERIENCE_YEARS[0] - 1 : SUITABILITY_EXPERIENCE_YEARS[bucket - 1];
+    }
+
+    int rowOf(const TraderProfile& trader) const {
+        return row(trader.typeCode(), trader.is_accredited, experienceBucket(trader.experience_years),
+                   trader.jurisdictionCode());
+    }
+
+public:
+    SuitabilityMatrix() { rebuild(); }
+
+    void rebuild() {
+        for (int t = 0; t < TRADER_TYPES; ++t) {
+            for (int a = 0; a < 2; ++a) {
+                for (int b = 0; b < EXPERIENCE_BUCKETS; ++b) {
+                    for (int j = 0; j < JURISDICTIONS; ++j) {
+                        int r = row(static_cast<TraderType>(t), a != 0, b, static_cast<Jurisdiction>(j));
+                        uint32_t products = 0;
+                        for (int p = 0; p < PRODUCTS; ++p) {
+                            RejectReason reason = suitabilityRule(
+                                static_cast<TraderType>(t), a != 0, bucketYears(b),
+                                static_cast<Jurisdiction>(j), static_cast<ProductType>(p));
+                            products |= static_cast<uint32_t>(reason == RejectReason::NONE) << p;
+                            reasons[r][p] = reason;
+                        }
+                        permitted[r] = products;
+                    }
+                }
+            }
+        }
+    }
+
+    bool permits(const TraderProfile& trader, ProductType product) const {
+        return (permitted[rowOf(trader)] >> static_cast<int>(product)) & 1u;
+    }
+
+    RejectReason reasonFor(const TraderProfile& trader, ProductType product) const {
+        return reasons[rowOf(trader)][static_cast<int>(product)];
+    }
+};
+
+// Safe for concurrent callers: per-trader state is updated with atomics in
+// cache-line-padded TraderStateTable slots (the shard mutexes only guard
+// slot assignment), and everything else read by the validators is
+// immutable while they run. rebuildSuitabilityMatrix() and loading a
+// RuntimeLimitsPolicy limit set must not overlap with validations; use
+// ReloadableLimitsPolicy to change limits during trading.
+template <typename LimitsPolicy>
+class BasicTradingRiskManager {
+private:
+    LimitsPolicy limits;
+    mutable TraderStateTable trader_states;
+    SuitabilityMatrix suitability;
+    MarketConditionsSeqlock market;
+    KillSwitch kill_switch;
+    RuleKernel rule_kernel = RuleKernel::BRANCHING;
+    
+public:
+    explicit BasicTradingRiskManager(size_t max_traders = 262144) : trader_states(max_traders) {}
+
+    LimitsPolicy& limitsPolicy() { return limits; }
+
+    // Not synchronized with concurrent validations; pick before starting
+    void setRuleKernel(RuleKernel kernel) { rule_kernel = kernel; }
+    RuleKernel ruleKernel() const { return rule_kernel; }
+
+    // Maps the trader to a dense state slot; call once per session before
+    // validating. Leaves state_slot INVALID_SLOT if the state table is full.
+    // Logging the profile into another manager moves it to that manager.
+    uint32_t loginTrader(TraderProfile& trader) {
+        trader.state_slot = trader_states.assignSlot(trader.trader_id);
+        trader.state_table = trader_states.id();
+        return trader.state_slot;
+    }
+    
+    // Business Rule: Validate trader eligibility
+    RiskDecision validateTraderEligibility(const TraderProfile& trader) {
+        if (rule_kernel == RuleKernel::BRANCHLESS) {
+            return validateTraderEligibilityBranchless(trader);
+        }
+        const auto lim = limits.snapshot();
+        uint16_t warnings = 0;
+
+        // Business Rule: Minimum experience requirement
+        if (trader.experience_years < lim->MIN_TRADING_EXPERIENCE) {
+            return RiskDecision::reject(RejectReason::INSUFFICIENT_EXPERIENCE, warnings);
+        }
+        
+        // Business Rule: Account balance requirement
+        if (trader.accountBalanceFx() < lim->MIN_ACCOUNT_BALANCE) {
+            return RiskDecision::reject(RejectReason::INSUFFICIENT_BALANCE, warnings);
+        }
+        
+        // Business Rule: Jurisdiction restrictions
+        if (trader.jurisdictionCode() == Jurisdiction::RESTRICTED ||
+            trader.jurisdictionCode() == Jurisdiction::SANCTIONED) {
+            return RiskDecision::reject(RejectReason::RESTRICTED_JURISDICTION, warnings);
+        }
+        
+        // Business Rule: Accreditation requirement for high-risk trading
+        if (trader.riskCode() == RiskLevel::HIGH && !trader.is_accredited) {
+            return RiskDecision::reject(RejectReason::ACCREDITATION_REQUIRED, warnings);
+        }
+        
+        // Business Rule: Pattern Day Trader rule compliance
+        if (trader.typeCode() == TraderType::RETAIL &&
+            trader.accountBalanceFx() < lim->PATTERN_DAY_TRADER_LIMIT) {
+            warnings |= WARN_PATTERN_DAY_TRADER;
+        }
+        
+        return RiskDecision::accept(warnings);
+    }
+    
+    // Business Rule: Validate individual trade order. A TradeOrder is
+    // ingested as it is built, so the TradeOrder overloads only copy out
+    // its hot record: no allocation, no symbol table lock (--alloc-check).
+    RiskDecision validateTradeOrder(const TradeOrder& order, const TraderProfile& trader) {
+        return validateTradeOrder(makeOrderHot(order), trader);
+    }
+
+    template <StateAccess Access = StateAccess::SHARED>
+    RiskDecision validateTradeOrder(const OrderHot& order, const TraderProfile& trader) {
+        if (rule_kernel == RuleKernel::BRANCHLESS) {
+            return validateTradeOrderBranchless<Access>(order, trader);
+        }
+        const auto lim = limits.snapshot();
+        uint16_t warnings = 0;
+
+        // Business Rule: Firm-wide and per-trader kill switches
+        if (kill_switch.anyEngaged()) {
+            RejectReason killed = killSwitchReason(trader);
+            if (killed != RejectReason::NONE) {
+                return RiskDecision::reject(killed, warnings);
+            }
+        }
+
+        // Business Rules: order size, volatility, short selling and margin
+        // limits, in that order (see orderRuleMask)
+        const uint32_t violations = static_cast<uint32_t>(orderRuleMask(order, orderRuleTrader(trader, lim), lim));
+        if (violations & kAheadOfDailyLimit) {
+            return RiskDecision::reject(firstViolation(violations), warnings);
+        }
+        
+        // Business Rule: Daily trade limit
+        // Accepting reserves one of the trader's daily trade slots
+        const uint32_t slot = slotOf(trader);
+        if (slot == TraderStateTable::INVALID_SLOT) {
+            return RiskDecision::reject(RejectReason::TRADER_CAPACITY_EXCEEDED, warnings);
+        }
+        if (!reserveTradeSlot<Access>(slot, lim->MAX_TRADES_PER_DAY)) {
+            return RiskDecision::reject(RejectReason::DAILY_TRADE_LIMIT, warnings);
+        }
+        
+        // Business Rule: Sector concentration limits
+        if (order.sector_code != Sector::DIVERSIFIED) {
+            // This would check against portfolio positions in real implementation
+            warnings |= WARN_SECTOR_CHECK_PENDING;
+        }
+        
+        // Business Rule: After-hours trading restrictions
+        if (violations & ruleBit(RejectReason::AFTER_HOURS_EXPERIENCE)) {
+            releaseTradeSlot<Access>(trader);
+            return RiskDecision::reject(RejectReason::AFTER_HOURS_EXPERIENCE, warnings);
+        }
+        
+        return RiskDecision::accept(warnings);
+    }
+
+    // Columnar validateTradeOrder. Decisions match validating the orders one
+    // at a time in batch order, but the stateless rules run as one
+    // vectorized pass over the columns and each trader's daily trade slots
+    // are reserved with a single update per batch. Order i is placed by
+    // traders[orders.trader[i]]; an index past the table is rejected with
+    // TRADER_CAPACITY_EXCEEDED, as for a trader without a state slot.
+    // Warnings are not reported. A level the CPU lacks is lowered to the
+    // widest one it has.
+    template <StateAccess Access = StateAccess::SHARED>
+    void validateTradeOrderBatch(const OrderColumns& orders, const std::vector<const TraderProfile*>& traders,
+                                 BatchDecisions& out, SimdLevel level = detectSimdLevel()) {
+        assert(traders.size() < INT32_MAX && "the batch kernels gather with signed 32-bit indices");
+        const auto lim = limits.snapshot();
+        const OrderRuleLimits order_limits{lim->MAX_ORDER_SIZE.raw, lim->LOW_RISK_MAX_VOLATILITY,
+                                           lim->RETAIL_SHORT_LIMIT.raw, lim->MAX_TRADES_PER_DAY};
+        const size_t count = orders.size();
+        const uint32_t reject_row = static_cast<uint32_t>(traders.size());
+        out.prepare(count, traders.size());
+        level = std::min(level, detectSimdLevel());
+
+        const bool killed = kill_switch.anyEngaged();
+        for (size_t t = 0; t < traders.size(); ++t) {
+            const TraderProfile& trader = *traders[t];
+            const OrderRuleTrader rules = orderRuleTrader(trader, lim);
+            RejectReason kill_reason = killed ? killSwitchReason(trader) : RejectReason::NONE;
+            out.slot[t] = slotOf(trader);
+            out.trader_rules[t] =
+                rules.rules |
+                (kill_reason != RejectReason::NONE ? static_cast<uint32_t>(ruleBit(kill_reason)) : 0) |
+                ruleIf(out.slot[t] == TraderStateTable::INVALID_SLOT, RejectReason::TRADER_CAPACITY_EXCEEDED);
+            out.margin_floor[t] = rules.margin_floor;
+        }
+        // The reject-all row: no order rule applies, no slot to reserve
+        out.trader_rules[reject_row] = static_cast<uint32_t>(ruleBit(RejectReason::TRADER_CAPACITY_EXCEEDED));
+        out.margin_floor[reject_row] = INT64_MAX;
+        out.slot[reject_row] = TraderStateTable::INVALID_SLOT;
+
+        // Pass 1: every rule that does not depend on the trade count, as one
+        // violation mask per order, and the orders numbered per trader
+        size_t covered = 0;
+#if defined(__x86_64__) || defined(__i386__)
+        if (level == SimdLevel::AVX512) {
+            covered = orderRuleViolationsAvx512(orders, order_limits, reject_row, out);
+        } else if (level == SimdLevel::AVX2) {
+            covered = orderRuleViolationsAvx2(orders, order_limits, reject_row, out);
+        }
+#endif
+        for (size_t i = covered; i < count; ++i) {
+            const uint32_t t = std::min(orders.trader[i], reject_row);
+            const uint32_t trader_rules = out.trader_rules[t];
+            out.trader[i] = t;
+            out.violations[i] = static_cast<uint32_t>(
+                orderRuleMask(orders.notional[i], orders.volatility[i], orders.type[i], orders.tif[i],
+                              orders.margin[i] != 0, OrderRuleTrader{trader_rules, out.margin_floor[t]}, lim)) |
+                (trader_rules & kTraderRejectRules);
+            numberBatchOrder(out, i);
+        }
+
+        for (size_t t = 0; t < traders.size(); ++t) {
+            if (out.slot[t] != TraderStateTable::INVALID_SLOT) {
+                out.granted[t] = reserveTradeSlots<Access>(out.slot[t], out.wanted[t], order_limits.max_trades_per_day,
+                                                           out.base[t]);
+            }
+        }
+
+        // Pass 2: resolve against the reservations
+#if defined(__x86_64__) || defined(__i386__)
+        if (level == SimdLevel::AVX512) {
+            resolveOrderBatchAvx512(count, order_limits.max_trades_per_day, out);
+            return;
+        }
+        if (level == SimdLevel::AVX2) {
+            resolveOrderBatchAvx2(count, order_limits.max_trades_per_day, out);
+            return;
+        }
+#endif
+        resolveOrderBatchScalar(0, count, order_limits.max_trades_per_day, out);
+    }
+
+    // An accepted order holds one daily trade slot until it is committed
+    // (filled) or released (cancelled, or rejected further downstream).
+    // No-ops for a trader without a state slot, who is never accepted.
+    template <StateAccess Access = StateAccess::SHARED>
+    void commitTradeSlot(const TraderProfile& trader) {
+        const uint32_t slot = slotOf(trader);
+        if (slot == TraderStateTable::INVALID_SLOT) {
+            return;
+        }
+        addToCount<Access>(trader_states[slot].trades_filled, 1);
+    }
+
+    template <StateAccess Access = StateAccess::SHARED>
+    void releaseTradeSlot(const TraderProfile& trader) {
+        const uint32_t slot = slotOf(trader);
+        if (slot == TraderStateTable::INVALID_SLOT) {
+            return;
+        }
+        addToCount<Access>(trader_states[slot].trade_count, -1);
+    }
+
+    // Trades committed today; the daily limit counts these plus open reservations
+    int filledTradesToday(const TraderProfile& trader) const {
+        const uint32_t slot = slotOf(trader);
+        if (slot == TraderStateTable::INVALID_SLOT) {
+            return 0;
+        }
+        return trader_states[slot].trades_filled.load(std::memory_order_relaxed);
+    }
+
+    // Start of a new trading day: clears every trader's counters
+    void resetDailyState() {
+        trader_states.resetDailyState();
+    }
+    
+    // Full-violation mode for validateTradeOrder: every rule is evaluated,
+    // without early exits, into a ruleBit/warningBits mask
+    uint64_t evaluateTradeOrderRules(const OrderHot& order, const TraderProfile& trader) const {
+        const auto lim = limits.snapshot();
+        int trades_today = tradesToday(trader);
+
+        uint64_t mask = 0;
+        if (kill_switch.anyEngaged()) {
+            RejectReason killed = killSwitchReason(trader);
+            mask |= killed != RejectReason::NONE ? ruleBit(killed) : 0;
+        }
+        mask |= orderRuleMask(order, orderRuleTrader(trader, lim), lim);
+        mask |= ruleIf(slotOf(trader) == TraderStateTable::INVALID_SLOT, RejectReason::TRADER_CAPACITY_EXCEEDED);
+        mask |= ruleIf(trades_today >= lim->MAX_TRADES_PER_DAY, RejectReason::DAILY_TRADE_LIMIT);
+        mask |= warningIf(order.sector_code != Sector::DIVERSIFIED, WARN_SECTOR_CHECK_PENDING);
+        return mask;
+    }
+
+    uint64_t evaluateTradeOrderRules(const TradeOrder& order, const TraderProfile& trader) const {
+        return evaluateTradeOrderRules(makeOrderHot(order), trader);
+    }
+
+    // Full-violation mode for validateTraderEligibility
+    uint64_t evaluateTraderEligibilityRules(const TraderProfile& trader) const {
+        const auto lim = limits.snapshot();
+        uint64_t mask = 0;
+        mask |= ruleIf(trader.experience_years < lim->MIN_TRADING_EXPERIENCE,
+                       RejectReason::INSUFFICIENT_EXPERIENCE);
+        mask |= ruleIf(trader.accountBalanceFx() < lim->MIN_ACCOUNT_BALANCE, RejectReason::INSUFFICIENT_BALANCE);
+        mask |= ruleIf((trader.jurisdictionCode() == Jurisdiction::RESTRICTED) |
+                           (trader.jurisdictionCode() == Jurisdiction::SANCTIONED),
+                       RejectReason::RESTRICTED_JURISDICTION);
+        mask |= ruleIf((trader.riskCode() == RiskLevel::HIGH) & !trader.is_accredited,
+                       RejectReason::ACCREDITATION_REQUIRED);
+        mask |= warningIf((trader.typeCode() == TraderType::RETAIL) &
+                              (trader.accountBalanceFx() < lim->PATTERN_DAY_TRADER_LIMIT),
+                          WARN_PATTERN_DAY_TRADER);
+        return mask;
+    }
+
+    // Full-violation mode for validatePortfolioRisk, over the same streaming
+    // pass. The per-position rules are evaluated once, on the largest position.
+    uint64_t evaluatePortfolioRiskRules(const std::vector<PortfolioPosition>& positions,
+                                        const TraderProfile& trader) const {
+        const auto lim = limits.snapshot();
+        PortfolioMetrics metrics;
+        for (const auto& position : positions) {
+            accumulatePosition(metrics, position.current_value, position.unrealized_pnl,
+                               position.risk_code == PositionRisk::HIGH_RISK, lim->MAX_POSITION_SIZE);
+        }
+        return portfolioRuleMask(metrics, metrics.max_position, trader, lim);
+    }
+    
+    // Business Rule: Portfolio risk assessment. One streaming pass gathers
+    // the totals and the largest position; the position size and 20%
+    // concentration rules are then checked once, on that position.
+    RiskDecision validatePortfolioRisk(const std::vector<PortfolioPosition>& positions,
+                                      const TraderProfile& trader) {
+        const auto lim = limits.snapshot();
+        PortfolioMetrics metrics;
+
+        // Business Rule: Calculate portfolio metrics
+        for (const auto& position : positions) {
+            accumulatePosition(metrics, position.current_value, position.unrealized_pnl,
+                               position.risk_code == PositionRisk::HIGH_RISK, lim->MAX_POSITION_SIZE);
+        }
+        return decidePortfolioRisk(metrics, trader, lim);
+    }
+
+    // Business Rule: Portfolio risk assessment, over a columnar portfolio.
+    // Same rules from one vectorized pass; see reducePortfolio for how its
+    // totals may differ from the sequential sum.
+    RiskDecision validatePortfolioRisk(const PortfolioStore& portfolio, const TraderProfile& trader,
+                                       SimdLevel level = detectSimdLevel()) {
+        const auto lim = limits.snapshot();
+        return decidePortfolioRisk(reducePortfolio(portfolio, lim->MAX_POSITION_SIZE, level), trader, lim);
+    }
+    
+    // Called by the market-data thread; validators see it via checkMarketConditions()
+    void publishMarketConditions(const MarketConditions& conditions) {
+        market.publish(conditions);
+    }
+
+    // Checks the latest published snapshot
+    RiskDecision checkMarketConditions() const {
+        return checkMarketConditions(market.read());
+    }
+
+    RiskDecision checkMarketConditions(double current_vix, const std::string& market_status) const {
+        return checkMarketConditions(MarketConditions{current_vix, parseMarketStatus(market_status), 0});
+    }
+
+    // Business Rule: Market condition restrictions
+    RiskDecision checkMarketConditions(const MarketConditions& conditions) const {
+        const auto lim = limits.snapshot();
+        uint16_t warnings = 0;
+
+        // Business Rule: Exchange or regulator declared halts
+        if (conditions.halt_flags != 0) {
+            return RiskDecision::reject(RejectReason::MARKET_HALTED, warnings);
+        }
+
+        // Business Rule: VIX-based trading halts
+        if (conditions.vix > lim->VIX_HALT_THRESHOLD) {
+            return RiskDecision::reject(RejectReason::VIX_HALT, warnings);
+        }
+        
+        // Business Rule: Market hours validation
+        if (conditions.status == MarketStatus::CLOSED) {
+            return RiskDecision::reject(RejectReason::MARKET_CLOSED, warnings);
+        }
+        
+        // Business Rule: Pre-market restrictions
+        if (conditions.status == MarketStatus::PRE_MARKET) {
+            warnings |= WARN_PRE_MARKET;
+        }
+        
+        return RiskDecision::accept(warnings);
+    }
+    
+    // Business Rule: Daily loss monitoring
+    // By id, for callers without the profile: a lookup under the shard
+    // mutex, rejecting traders that never logged in. The profile overloads
+    // below are the lock-free path.
+    RiskDecision checkDailyLossLimits(int trader_id, double trade_loss) {
+        return checkDailyLossLimitsForSlot(trader_states.findSlot(trader_id), Fixed::fromDouble(trade_loss));
+    }
+
+    RiskDecision checkDailyLossLimits(const TraderProfile& trader, double trade_loss) {
+        return checkDailyLossLimitsForSlot(slotOf(trader), Fixed::fromDouble(trade_loss));
+    }
+
+    template <StateAccess Access = StateAccess::SHARED>
+    RiskDecision checkDailyLossLimits(const TraderProfile& trader, Fixed trade_loss) {
+        return checkDailyLossLimitsForSlot<Access>(slotOf(trader), trade_loss);
+    }
+
+    // Kill switches: every later validateTradeOrder rejects until lifted
+    void haltTrading() { kill_switch.haltFirm(); }
+
+    void resumeTrading() { kill_switch.resumeFirm(); }
+
+    bool suspendTrader(const TraderProfile& trader) {
+        const uint32_t slot = slotOf(trader);
+        if (slot == TraderStateTable::INVALID_SLOT) {
+            return false;
+        }
+        return kill_switch.suspend(trader_states[slot]);
+    }
+
+    bool resumeTrader(const TraderProfile& trader) {
+        const uint32_t slot = slotOf(trader);
+        if (slot == TraderStateTable::INVALID_SLOT) {
+            return false;
+        }
+        return kill_switch.resume(trader_states[slot]);
+    }
+
+    // Traders in the same state shard share an owner in ShardPipeline
+    uint32_t stateShardOf(const TraderProfile& trader) const {
+        const uint32_t slot = slotOf(trader);
+        if (slot == TraderStateTable::INVALID_SLOT) {
+            return 0;
+        }
+        return trader_states.shardOfSlot(slot);
+    }
+
+    uint32_t stateShardCount() const { return trader_states.shardCount(); }
+
+    // See TraderStateTable::placeShard
+    void placeStateShard(uint32_t shard, int node = -1) {
+        trader_states.placeShard(shard, node);
+    }
+    
+    // Business Rule: Client suitability assessment
+    RiskDecision assessClientSuitability(const TraderProfile& trader, const std::string& product_type) {
+        return assessClientSuitability(trader, parseProductType(product_type));
+    }
+
+    // A single bit test against the compiled permission matrix
+    RiskDecision assessClientSuitability(const TraderProfile& trader, ProductType product) const {
+        if (suitability.permits(trader, product)) {
+            return RiskDecision::accept(0);
+        }
+        return RiskDecision::reject(suitability.reasonFor(trader, product), 0);
+    }
+
+    // Recompiles the permission matrix; call after changing suitabilityRule()
+    void rebuildSuitabilityMatrix() {
+        suitability.rebuild();
+    }
+    
+    // Business Rule: Order routing and execution rules
+    RiskDecision validateOrderExecution(const TradeOrder& order, const std::string& venue) {
+        return validateOrderExecution(makeOrderHot(order), venue);
+    }
+
+    RiskDecision validateOrderExecution(const OrderHot& order, const std::string& venue) {
+        uint16_t warnings = 0;
+
+        // Business Rule: Large order routing requirements
+        if (order.notional_fx > Fixed::fromUnits(500000)) {
+            if (venue != "DARK_POOL" && venue != "INSTITUTIONAL_NETWORK") {
+                warnings |= WARN_DARK_POOL_ROUTING;
+            }
+        }
+        
+        // Business Rule: Best execution requirements
+        if (order.type_code == OrderType::MARKET && order.quantity_fx > Fixed::fromUnits(10000)) {
+            warnings |= WARN_PRICE_IMPACT;
+        }
+        
+        // Business Rule: Venue-specific restrictions
+        if (venue == "RETAIL_VENUE" && order.quantity_fx > Fixed::fromUnits(100000)) {
+            return RiskDecision::reject(RejectReason::RETAIL_VENUE_SIZE, warnings);
+        }
+        
+        return RiskDecision::accept(warnings);
+    }
+
+private:
+    // RuleKernel::BRANCHLESS form of validateTraderEligibility
+    RiskDecision validateTraderEligibilityBranchless(const TraderProfile& trader) const {
+        uint64_t mask = evaluateTraderEligibilityRules(trader);
+        RejectReason reason = firstViolationBranchless(static_cast<uint32_t>(mask));
+        // The day-trader warning is only reached by accepted traders
+        uint16_t warnings = static_cast<uint16_t>((mask >> 32) * (reason == RejectReason::NONE));
+        return RiskDecision{reason == RejectReason::NONE, reason, warnings};
+    }
+
+    // RuleKernel::BRANCHLESS form of validateTradeOrder. One data-dependent
+    // branch is left: only an order clear of every rule ahead of the daily
+    // limit goes on to the trade count. An extended-hours order failing on
+    // experience then just reads the count, where the if chain reserves a
+    // slot and releases it; the decision is the same.
+    template <StateAccess Access>
+    RiskDecision validateTradeOrderBranchless(const OrderHot& order, const TraderProfile& trader) {
+        const auto lim = limits.snapshot();
+
+        // Business Rule: Firm-wide and per-trader kill switches
+        if (kill_switch.anyEngaged()) {
+            RejectReason killed = killSwitchReason(trader);
+            if (killed != RejectReason::NONE) {
+                return RiskDecision::reject(killed, 0);
+            }
+        }
+
+        const uint32_t rules = static_cast<uint32_t>(orderRuleMask(order, orderRuleTrader(trader, lim), lim));
+        const uint32_t slot = slotOf(trader);
+        uint32_t violations = (rules & kAheadOfDailyLimit) |
+                              ruleIf(slot == TraderStateTable::INVALID_SLOT, RejectReason::TRADER_CAPACITY_EXCEEDED);
+        uint32_t extended_hours = (rules >> static_cast<unsigned>(RejectReason::AFTER_HOURS_EXPERIENCE)) & 1;
+
+        RejectReason first = firstViolationBranchless(violations);
+        uint32_t pending = first == RejectReason::NONE;
+        uint32_t over_limit = 0;
+        if (pending) {
+            int base;
+            reserveTradeSlots<Access>(slot, extended_hours ^ 1, lim->MAX_TRADES_PER_DAY, base);
+            over_limit = base >= lim->MAX_TRADES_PER_DAY;
+        }
+        uint32_t resolved = over_limit * static_cast<uint32_t>(RejectReason::DAILY_TRADE_LIMIT) +
+                            ((over_limit ^ 1) & extended_hours) *
+                                static_cast<uint32_t>(RejectReason::AFTER_HOURS_EXPERIENCE);
+        uint32_t reason = static_cast<uint32_t>(first) | pending * resolved;
+        // Business Rule: Sector concentration limits, flagged once the order holds a slot
+        uint16_t warnings = static_cast<uint16_t>(pending & (over_limit ^ 1) &
+                                                  (order.sector_code != Sector::DIVERSIFIED)) *
+                            WARN_SECTOR_CHECK_PENDING;
+        return RiskDecision{reason == 0, static_cast<RejectReason>(reason), warnings};
+    }
+
+    // The trader half of the stateless order rules: which of them an order
+    // from this trader can trip. exceedsFraction(value, margin, multiple, 1)
+    // is value > margin * multiple, so the margin rule becomes value >=
+    // margin_floor, and a trader whose product is beyond any notional is
+    // not subject to it.
+    template <typename Snapshot>
+    static OrderRuleTrader orderRuleTrader(const TraderProfile& trader, const Snapshot& lim) {
+        uint64_t rules = ruleBit(RejectReason::ORDER_SIZE_LIMIT);
+        // Business Rule: Volatility-based restrictions
+        rules |= ruleIf(trader.riskCode() == RiskLevel::LOW, RejectReason::VOLATILITY_RESTRICTED);
+        // Business Rule: Short selling restrictions
+        rules |= ruleIf(trader.typeCode() == TraderType::RETAIL, RejectReason::RETAIL_SHORT_LIMIT);
+        // Business Rule: Margin trading eligibility
+        __int128 margin_limit = static_cast<__int128>(trader.availableMarginFx().raw) * lim->MARGIN_ORDER_MULTIPLE;
+        rules |= ruleIf(margin_limit < INT64_MAX, RejectReason::INSUFFICIENT_MARGIN);
+        int64_t margin_floor = margin_limit < INT64_MIN   ? INT64_MIN
+                               : margin_limit < INT64_MAX ? static_cast<int64_t>(margin_limit) + 1
+                                                          : INT64_MAX;
+        // Business Rule: After-hours trading restrictions
+        rules |= ruleIf(trader.experience_years < lim->AFTER_HOURS_MIN_EXPERIENCE,
+                        RejectReason::AFTER_HOURS_EXPERIENCE);
+        return OrderRuleTrader{static_cast<uint32_t>(rules), margin_floor};
+    }
+
+    // The stateless order rules, as violation bits: the conditions this
+    // order meets, kept where the trader is subject to the rule. Every
+    // validateTradeOrder form (if chain, branchless, batch, full-violation)
+    // decides from these two halves, so the rules and their limits are
+    // written once; the batch kernels repeat the order half across lanes.
+    // The kill switches, state slot and daily trade limit read per-trader
+    // state and stay with the callers.
+    template <typename Snapshot>
+    static uint64_t orderRuleMask(Fixed order_value, double volatility, OrderType type, TimeInForce tif,
+                                  bool margin_trade, const OrderRuleTrader& trader, const Snapshot& lim) {
+        uint64_t mask = 0;
+        // Business Rule: Maximum order size limit
+        mask |= ruleIf(order_value > lim->MAX_ORDER_SIZE, RejectReason::ORDER_SIZE_LIMIT);
+        // Business Rule: Volatility-based restrictions
+        mask |= ruleIf(volatility > lim->LOW_RISK_MAX_VOLATILITY, RejectReason::VOLATILITY_RESTRICTED);
+        // Business Rule: Short selling restrictions
+        mask |= ruleIf((type == OrderType::SHORT) & (order_value > lim->RETAIL_SHORT_LIMIT),
+                       RejectReason::RETAIL_SHORT_LIMIT);
+        // Business Rule: Margin trading eligibility
+        mask |= ruleIf(margin_trade & (order_value.raw >= trader.margin_floor), RejectReason::INSUFFICIENT_MARGIN);
+        // Business Rule: After-hours trading restrictions
+        mask |= ruleIf(tif == TimeInForce::EXTENDED_HOURS, RejectReason::AFTER_HOURS_EXPERIENCE);
+        return mask & trader.rules;
+    }
+
+    template <typename Snapshot>
+    static uint64_t orderRuleMask(const OrderHot& order, const OrderRuleTrader& trader, const Snapshot& lim) {
+        return orderRuleMask(order.notional_fx, order.volatility_score, order.type_code, order.tif_code,
+                             order.is_margin_trade, trader, lim);
+    }
+
+    // The portfolio rules over the metrics of one pass, as ruleBit/warningBits
+    // in validatePortfolioRisk order, so a lower reject bit is decided first.
+    // The 20% concentration rule is judged on largest: the largest position
+    // the caller's pass looks at. Both the first-fail and full-violation
+    // modes decide from this mask. lim must be the snapshot the metrics were
+    // reduced against.
+    template <typename Snapshot>
+    static uint64_t portfolioRuleMask(const PortfolioMetrics& metrics, double largest, const TraderProfile& trader,
+                                      const Snapshot& lim) {
+        const double leverage_ratio = metrics.total_value / trader.accountBalance();
+        const double margin_equity_ratio = trader.accountBalance() / metrics.total_value;
+        uint64_t mask = 0;
+        // Business Rule: Maximum portfolio loss limit
+        mask |= warningIf(metrics.unrealized_loss > trader.accountBalance() * 0.20, WARN_PORTFOLIO_LOSS);
+        // Business Rule: Position size limits
+        mask |= ruleIf(metrics.oversized, RejectReason::POSITION_SIZE_LIMIT);
+        // Business Rule: Single position concentration limit
+        mask |= warningIf(largest > metrics.total_value * 0.20, WARN_POSITION_CONCENTRATION);
+        // Business Rule: High-risk exposure limits
+        mask |= ruleIf(metrics.high_risk_exposure > metrics.total_value * lim->HIGH_RISK_THRESHOLD,
+                       RejectReason::HIGH_RISK_EXPOSURE);
+        // Business Rule: Leverage ratio check
+        mask |= ruleIf(leverage_ratio > lim->MAX_LEVERAGE_RATIO, RejectReason::LEVERAGE_LIMIT);
+        // Business Rule: Margin call assessment
+        mask |= warningIf(margin_equity_ratio < lim->MARGIN_CALL_THRESHOLD, WARN_MARGIN_CALL);
+        // Business Rule: Forced liquidation trigger
+        mask |= ruleIf(margin_equity_ratio < lim->FORCED_LIQUIDATION, RejectReason::FORCED_LIQUIDATION);
+        return mask;
+    }
+
+    // First-fail decision over portfolioRuleMask. A first-fail pass stops at
+    // an oversized position, so concentration is judged on the positions
+    // ahead of it, and a rejection ahead of the margin call assessment drops
+    // its warning.
+    template <typename Snapshot>
+    static RiskDecision decidePortfolioRisk(const PortfolioMetrics& metrics, const TraderProfile& trader,
+                                            const Snapshot& lim) {
+        const uint64_t mask = portfolioRuleMask(metrics, metrics.max_before_oversized, trader, lim);
+        uint16_t warnings = static_cast<uint16_t>(mask >> 32);
+        if (mask & kAheadOfMarginCall) {
+            warnings &= static_cast<uint16_t>(~WARN_MARGIN_CALL);
+        }
+        const RejectReason reason = firstViolation(mask);
+        return reason == RejectReason::NONE ? RiskDecision::accept(warnings) : RiskDecision::reject(reason, warnings);
+    }
+
+    // The trader's slot in this manager's table, or INVALID_SLOT if the
+    // profile was never logged in here
+    uint32_t slotOf(const TraderProfile& trader) const {
+        return trader.state_table == trader_states.id() ? trader.state_slot : TraderStateTable::INVALID_SLOT;
+    }
+
+    // Slow path, taken only while some switch is engaged
+    RejectReason killSwitchReason(const TraderProfile& trader) const {
+        if (kill_switch.firmHalted()) {
+            return RejectReason::FIRM_KILL_SWITCH;
+        }
+        const uint32_t slot = slotOf(trader);
+        if (slot != TraderStateTable::INVALID_SLOT &&
+            trader_states[slot].suspended.load(std::memory_order_relaxed) != 0) {
+            return RejectReason::TRADER_SUSPENDED;
+        }
+        return RejectReason::NONE;
+    }
+
+    int tradesToday(const TraderProfile& trader) const {
+        const uint32_t slot = slotOf(trader);
+        if (slot == TraderStateTable::INVALID_SLOT) {
+            return 0;
+        }
+        return trader_states[slot].trade_count.load(std::memory_order_relaxed);
+    }
+
+    // Fetch-add with rollback: a reservation succeeds only if the count it
+    // incremented was below the limit, so concurrent orders from one trader
+    // can never overshoot. (A racing attempt that is about to roll back can
+    // make another fail spuriously right at the limit.)
+    template <StateAccess Access>
+    bool reserveTradeSlot(uint32_t slot, int limit) {
+        std::atomic<int>& count = trader_states[slot].trade_count;
+        if (Access == StateAccess::OWNER) {
+            int current = count.load(std::memory_order_relaxed);
+            if (current >= limit) {
+                return false;
+            }
+            count.store(current + 1, std::memory_order_relaxed);
+            return true;
+        }
+        if (count.fetch_add(1, std::memory_order_relaxed) >= limit) {
+            count.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    // Reserves up to wanted slots at once; returns how many were granted
+    // and sets base to the count before them. Traders with nothing to
+    // reserve just read their count.
+    template <StateAccess Access>
+    int reserveTradeSlots(uint32_t slot, int wanted, int limit, int& base) {
+        std::atomic<int>& count = trader_states[slot].trade_count;
+        if (Access == StateAccess::OWNER || wanted == 0) {
+            base = count.load(std::memory_order_relaxed);
+            int granted = std::max(0, std::min(wanted, limit - base));
+            if (granted != 0) {
+                count.store(base + granted, std::memory_order_relaxed);
+            }
+            return granted;
+        }
+        base = count.fetch_add(wanted, std::memory_order_relaxed);
+        int granted = std::max(0, std::min(wanted, limit - base));
+        if (granted != wanted) {
+            count.fetch_sub(wanted - granted, std::memory_order_relaxed);
+        }
+        return granted;
+    }
+
+    // CAS loop rather than fetch_add so the running total saturates
+    // instead of wrapping; returns the total including this loss
+    template <StateAccess Access>
+    static Fixed accumulateDailyLoss(TraderDailyState& state, Fixed trade_loss) {
+        int64_t current = state.daily_loss_raw.load(std::memory_order_relaxed);
+        int64_t updated;
+        do {
+            if (__builtin_add_overflow(current, trade_loss.raw, &updated)) {
+                updated = trade_loss.raw > 0 ? INT64_MAX : -INT64_MAX;
+            }
+            if (Access == StateAccess::OWNER) {
+                state.daily_loss_raw.store(updated, std::memory_order_relaxed);
+                break;
+            }
+        } while (!state.daily_loss_raw.compare_exchange_weak(current, updated, std::memory_order_relaxed));
+        return Fixed{updated};
+    }
+
+    // True for exactly one caller per latch per day, however many race here
+    template <StateAccess Access>
+    static bool latchLossEvent(TraderDailyState& state, LossEventLatch latch) {
+        uint8_t events = state.loss_events.load(std::memory_order_relaxed);
+        if (events & latch) {
+            return false;
+        }
+        if (Access == StateAccess::OWNER) {
+            state.loss_events.store(events | latch, std::memory_order_relaxed);
+            return true;
+        }
+        return !(state.loss_events.fetch_or(latch, std::memory_order_relaxed) & latch);
+    }
+
+    template <StateAccess Access, typename Count>
+    static void addToCount(std::atomic<Count>& count, Count delta) {
+        if (Access == StateAccess::OWNER) {
+            count.store(count.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        } else {
+            count.fetch_add(delta, std::memory_order_relaxed);
+        }
+    }
+
+    template <StateAccess Access = StateAccess::SHARED>
+    RiskDecision checkDailyLossLimitsForSlot(uint32_t slot, Fixed trade_loss) {
+        const auto lim = limits.snapshot();
+        uint16_t warnings = 0;
+
+        if (slot == TraderStateTable::INVALID_SLOT) {
+            return RiskDecision::reject(RejectReason::TRADER_CAPACITY_EXCEEDED, warnings);
+        }
+        TraderDailyState& state = trader_states[slot];
+        Fixed daily_loss = accumulateDailyLoss<Access>(state, trade_loss);
+        bool over_limit = daily_loss > lim->MAX_DAILY_LOSS;
+        bool over_warning = exceedsFraction(daily_loss, lim->MAX_DAILY_LOSS, 3, 4);
+        if (over_warning && latchLossEvent<Access>(state, LOSS_WARNING_REPORTED)) {
+            warnings |= WARN_DAILY_LOSS_75_CROSSED;
+        }
+        if (over_limit && latchLossEvent<Access>(state, LOSS_LIMIT_REPORTED)) {
+            warnings |= WARN_DAILY_LOSS_LIMIT_CROSSED;
+            // Business Rule: Suspend the trader on a daily loss breach
+            if (lim->SUSPEND_ON_DAILY_LOSS_LIMIT) {
+                kill_switch.suspend(state);
+            }
+        }
+        
+        // Business Rule: Daily loss limit enforcement
+        if (over_limit) {
+            return RiskDecision::reject(RejectReason::DAILY_LOSS_LIMIT, warnings);
+        }
+        
+        // Business Rule: Warning at 75% of daily limit
+        if (over_warning) {
+            warnings |= WARN_DAILY_LOSS_APPROACHING;
+        }
+        
+        return RiskDecision::accept(warnings);
+    }
+};
+
+// Standard deployment: firm limits folded in at compile time
+using TradingRiskManager = BasicTradingRiskManager<CompiledLimitsPolicy>;
+
+// Fixed-capacity single-producer/single-consumer ring. Slots are allocated
+// once; each side publishes its index with a release store and keeps a
+// cached copy of the other side's index, so the steady state touches no
+// shared cache line except the slot being handed over.
+template <typename T>
+class SpscRing {
+private:
+    std::unique_ptr<T[]> slots;
+    uint64_t mask;
+    alignas(64) std::atomic<uint64_t> head{0};  // next slot to write
+    uint64_t cached_tail = 0;
+    alignas(64) std::atomic<uint64_t> tail{0};  // next slot to read
+    uint64_t cached_head = 0;
+
+public:
+    // capacity must be a power of two
+    explicit SpscRing(uint64_t capacity) : slots(new T[capacity]), mask(capacity - 1) {}
+
+    bool tryPush(const T& item) {
+        uint64_t position = head.load(std::memory_order_relaxed);
+        if (position - cached_tail > mask) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (position - cached_tail > mask) {
+                return false;
+            }
+        }
+        slots[position & mask] = item;
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& item) {
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        if (position == cached_head) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (position == cached_head) {
+                return false;
+            }
+        }
+        item = slots[position & mask];
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool empty() const {
+        return tail.load(std::memory_order_relaxed) == head.load(std::memory_order_acquire);
+    }
+};
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Thread placement and parking for validator threads. Off Linux, pinning
+// is unavailable and parking degrades to yielding.
+inline bool pinThreadToCpu(int cpu) {
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit int");
+
+// Sleeps while word == expected (or until woken)
+inline void futexWait(std::atomic<uint32_t>& word, uint32_t expected) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)expected;
+    std::this_thread::yield();
+#endif
+}
+
+inline void futexWakeOne(std::atomic<uint32_t>& word) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+inline uint64_t threadCpuNs() {
+#ifdef __linux__
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000u + now.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
+enum class PipelineOp : unsigned char { VALIDATE_ORDER, CHECK_DAILY_LOSS };
+
+struct PipelineRequest {
+    PipelineOp op;
+    const TraderProfile* trader;
+    const OrderHot* order;     // VALIDATE_ORDER
+    Fixed trade_loss;          // CHECK_DAILY_LOSS
+    int64_t submitted_ns;      // gateway timestamp, for latency accounting
+};
+
+// How an idle validator waits for its next request
+enum class IdleStrategy {
+    YIELD,           // spin with sched_yield: shares the core politely
+    BUSY_POLL,       // spin on the ring: lowest latency, a full core per worker
+    POLL_THEN_PARK,  // spin for spin_ns when the ring runs dry, then sleep on a futex
+};
+
+struct PipelineConfig {
+    IdleStrategy idle = IdleStrategy::YIELD;
+    int64_t spin_ns = 50000;       // POLL_THEN_PARK: idle time before parking
+    std::vector<int> cpus;         // worker i is pinned to cpus[i % size]; empty: no pinning
+    uint64_t ring_capacity = 4096;
+};
+
+// Per-worker counters, written only by the worker. Latency is gateway
+// submit (PipelineRequest::submitted_ns, when non-zero) to decision, kept
+// in a log-linear histogram: 8 sub-buckets per power of two.
+struct alignas(64) ValidatorThreadStats {
+    static const int kSubBuckets = 8;
+    static const int kBuckets = 62 * kSubBuckets;
+
+    uint64_t requests = 0;
+    uint64_t parks = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t cpu_ns = 0;  // worker thread CPU time, set when it exits
+    uint64_t histogram[kBuckets] = {};
+
+    static int bucketOf(uint64_t ns) {
+        if (ns < kSubBuckets) {
+            return static_cast<int>(ns);
+        }
+        int msb = 63 - __builtin_clzll(ns);
+        return (msb - 2) * kSubBuckets + static_cast<int>((ns >> (msb - 3)) & (kSubBuckets - 1));
+    }
+
+    // Largest value that falls in bucket
+    static uint64_t bucketLimit(int bucket) {
+        if (bucket < kSubBuckets) {
+            return bucket;
+        }
+        int msb = bucket / kSubBuckets + 2;
+        uint64_t width = 1ull << (msb - 3);
+        return (kSubBuckets + bucket % kSubBuckets) * width + width - 1;
+    }
+
+    void record(uint64_t ns) {
+        ++requests;
+        total_ns += ns;
+        max_ns = std::max(max_ns, ns);
+        ++histogram[bucketOf(ns)];
+    }
+
+    uint64_t percentileNs(double quantile) const {
+        uint64_t rank = static_cast<uint64_t>(quantile * requests);
+        uint64_t seen = 0;
+        for (int bucket = 0; bucket < kBuckets; ++bucket) {
+            seen += histogram[bucket];
+            if (seen > rank) {
+                return std::min(bucketLimit(bucket), max_ns);
+            }
+        }
+        return max_ns;
+    }
+};
+
+// Single-writer validation pipeline. Every state shard of the manager is
+// owned by exactly one worker thread, so validateTradeOrder and
+// checkDailyLossLimits run in StateAccess::OWNER mode with no atomic
+// read-modify-writes. One gateway thread calls submit(), which routes each
+// request to its owner's ring. The handler runs on the owner thread as
+// handler(worker, request, decision) and may itself call OWNER-mode
+// methods for that trader (e.g. releaseTradeSlot on a cancel).
+//
+// PipelineConfig picks the run mode: pinned busy-polling workers for the
+// lowest latency, futex parking after a spin for the lowest CPU use.
+template <typename Manager, typename Handler>
+class ShardPipeline {
+private:
+    struct alignas(64) ParkWord {
+        std::atomic<uint32_t> parked{0};
+    };
+
+    Manager& manager;
+    Handler handler;
+    PipelineConfig config;
+    std::vector<std::unique_ptr<SpscRing<PipelineRequest>>> rings;
+    std::unique_ptr<ParkWord[]> park_words;
+    std::unique_ptr<ValidatorThreadStats[]> stats;
+    std::vector<std::thread> workers;
+    std::atomic<bool> stopping{false};
+    std::atomic<unsigned> placed_workers{0};
+
+    // Pins the worker if cpus are configured, otherwise spreads workers
+    // over NUMA nodes, then moves each owned shard's state onto the
+    // worker's node before it validates anything
+    void placeOwnedShards(unsigned worker) {
+        int node = -1;
+        if (!config.cpus.empty()) {
+            pinThreadToCpu(config.cpus[worker % config.cpus.size()]);
+        } else if (numaNodeCount() > 1) {
+            node = static_cast<int>(worker % numaNodeCount());
+            runOnNumaNode(node);
+        }
+        for (uint32_t shard = worker; shard < manager.stateShardCount(); shard += workerCount()) {
+            manager.placeStateShard(shard, node);
+        }
+        placed_workers.fetch_add(1, std::memory_order_release);
+    }
+
+    // Sleeps until submit() or stop() clears the park word. The fence pairs
+    // with the one in wake(): either the gateway sees parked set, or this
+    // thread sees the request it pushed.
+    void park(unsigned worker, const SpscRing<PipelineRequest>& ring) {
+        std::atomic<uint32_t>& parked = park_words[worker].parked;
+        parked.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ring.empty() && !stopping.load(std::memory_order_relaxed)) {
+            ++stats[worker].parks;
+            futexWait(parked, 1);
+        }
+        parked.store(0, std::memory_order_relaxed);
+    }
+
+    void wake(unsigned worker) {
+        std::atomic<uint32_t>& parked = park_words[worker].parked;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked.load(std::memory_order_relaxed) != 0) {
+            parked.store(0, std::memory_order_relaxed);
+            futexWakeOne(parked);
+        }
+    }
+
+    void idle(unsigned worker, const SpscRing<PipelineRequest>& ring, uint32_t& empty_polls,
+              int64_t& idle_since_ns) {
+        switch (config.idle) {
+            case IdleStrategy::YIELD:
+                std::this_thread::yield();
+                break;
+            case IdleStrategy::BUSY_POLL:
+                cpuRelax();
+                break;
+            case IdleStrategy::POLL_THEN_PARK:
+                // Reads the clock only every 64 empty polls
+                if (empty_polls++ == 0) {
+                    idle_since_ns = steadyNowNs();
+                } else if ((empty_polls & 63) == 0 && steadyNowNs() - idle_since_ns > config.spin_ns) {
+                    park(worker, ring);
+                    empty_polls = 0;
+                } else {
+                    cpuRelax();
+                }
+                break;
+        }
+    }
+
+    void run(unsigned worker) {
+        placeOwnedShards(worker);
+        SpscRing<PipelineRequest>& ring = *rings[worker];
+        ValidatorThreadStats& worker_stats = stats[worker];
+        PipelineRequest request;
+        uint32_t empty_polls = 0;
+        int64_t idle_since_ns = 0;
+        for (;;) {
+            if (!ring.tryPop(request)) {
+                if (stopping.load(std::memory_order_acquire) && !ring.tryPop(request)) {
+                    break;
+                }
+                idle(worker, ring, empty_polls, idle_since_ns);
+                continue;
+            }
+            empty_polls = 0;
+            RiskDecision decision = request.op == PipelineOp::VALIDATE_ORDER
+                ? manager.template validateTradeOrder<StateAccess::OWNER>(*request.order, *request.trader)
+                : manager.template checkDailyLossLimits<StateAccess::OWNER>(*request.trader, request.trade_loss);
+            handler(worker, request, decision);
+            if (request.submitted_ns != 0) {
+                worker_stats.record(static_cast<uint64_t>(steadyNowNs() - request.submitted_ns));
+            }
+        }
+        worker_stats.cpu_ns = threadCpuNs();
+    }
+
+public:
+    // worker_count is clamped to the manager's shard count so that every
+    // worker owns at least one shard
+    ShardPipeline(Manager& risk_manager, unsigned worker_count, Handler on_decision,
+                  const PipelineConfig& run_mode = PipelineConfig())
+        : manager(risk_manager), handler(on_decision), config(run_mode) {
+        worker_count = std::max(1u, std::min(worker_count, manager.stateShardCount()));
+        for (unsigned i = 0; i < worker_count; ++i) {
+            rings.emplace_back(new SpscRing<PipelineRequest>(config.ring_capacity));
+        }
+        park_words.reset(new ParkWord[worker_count]);
+        stats.reset(new ValidatorThreadStats[worker_count]);
+    }
+
+    ~ShardPipeline() { stop(); }
+
+    unsigned workerCount() const { return static_cast<unsigned>(rings.size()); }
+
+    unsigned ownerOf(const TraderProfile& trader) const {
+        return manager.stateShardOf(trader) % workerCount();
+    }
+
+    // Returns once every worker has placed its shards
+    void start() {
+        for (unsigned i = 0; i < workerCount(); ++i) {
+            workers.emplace_back([this, i] { run(i); });
+        }
+        while (placed_workers.load(std::memory_order_acquire) != workerCount()) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Gateway side; waits while the owner's ring is full
+    void submit(const PipelineRequest& request) {
+        unsigned owner = ownerOf(*request.trader);
+        SpscRing<PipelineRequest>& ring = *rings[owner];
+        while (!ring.tryPush(request)) {
+            std::this_thread::yield();
+        }
+        if (config.idle == IdleStrategy::POLL_THEN_PARK) {
+            wake(owner);
+        }
+    }
+
+    // Drains every ring, then joins the workers
+    void stop() {
+        stopping.store(true, std::memory_order_seq_cst);
+        for (unsigned i = 0; i < workerCount(); ++i) {
+            wake(i);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+    }
+
+    // Read once stop() has returned
+    const ValidatorThreadStats& threadStats(unsigned worker) const { return stats[worker]; }
+};
+
+// Executor for batch jobs (end-of-day, replay). parallelFor hands each
+// worker an equal slice of the index range. A worker splits its current
+// range in half, keeps the lower half and pushes the upper half onto its
+// own deque, so the largest unstarted pieces sit at the front where idle
+// workers steal them. Uneven item costs (a few huge portfolios among many
+// small ones) therefore spread across workers instead of stalling one.
+class WorkStealingPool {
+private:
+    struct Job {
+        void (*invoke)(const void* fn, size_t index);
+        const void* fn;
+        size_t grain;
+        std::atomic<size_t> remaining;
+        // Set by the first call that throws; later items are skipped
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+    };
+
+    struct Range {
+        Job* job;
+        size_t begin;
+        size_t end;
+    };
+
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    unsigned worker_count;
+    std::unique_ptr<WorkerQueue[]> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::atomic<unsigned> sleepers{0};
+    std::mutex sleep_mutex;
+    std::condition_variable work_available;
+    std::condition_variable job_done;
+    std::mutex submit_mutex;
+    bool stopping = false;
+
+    void push(unsigned worker, const Range& range) {
+        {
+            std::lock_guard<std::mutex> lock(queues[worker].mutex);
+            queues[worker].ranges.push_back(range);
+        }
+        queued.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) != 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            work_available.notify_one();
+        }
+    }
+
+    // Own work from the back (most recently split, smallest), stolen work
+    // from the front of a victim's deque (oldest, largest)
+    bool take(unsigned worker, Range& range) {
+        const unsigned count = workerCount();
+        for (unsigned k = 0; k < count; ++k) {
+            unsigned victim = (worker + k) % count;
+            std::lock_guard<std::mutex> lock(queues[victim].mutex);
+            std::deque<Range>& ranges = queues[victim].ranges;
+            if (ranges.empty()) {
+                continue;
+            }
+            if (k == 0) {
+                range = ranges.back();
+                ranges.pop_back();
+            } else {
+                range = ranges.front();
+                ranges.pop_front();
+            }
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void execute(unsigned worker, Range range) {
+        Job& job = *range.job;
+        while (range.end - range.begin > job.grain) {
+            size_t middle = range.begin + (range.end - range.begin) / 2;
+            push(worker, Range{range.job, middle, range.end});
+            range.end = middle;
+        }
+        if (!job.failed.load(std::memory_order_relaxed)) {
+            try {
+                for (size_t i = range.begin; i < range.end; ++i) {
+                    job.invoke(job.fn, i);
+                }
+            } catch (...) {
+                // Published to parallelFor by the release on remaining below
+                if (!job.failed.exchange(true, std::memory_order_relaxed)) {
+                    job.error = std::current_exception();
+                }
+            }
+        }
+        // Skipped and failed items count as done, so parallelFor still returns
+        if (job.remaining.fetch_sub(range.end - range.begin, std::memory_order_acq_rel) ==
+            range.end - range.begin) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            job_done.notify_all();
+        }
+    }
+
+    void run(unsigned worker) {
+        Range range;
+        for (;;) {
+            if (take(worker, range)) {
+                execute(worker, range);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            work_available.wait(lock, [this] {
+                return stopping || queued.load(std::memory_order_seq_cst) != 0;
+            });
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            if (stopping) {
+                return;
+            }
+        }
+    }
+
+public:
+    explicit WorkStealingPool(unsigned threads = std::thread::hardware_concurrency())
+        : worker_count(std::max(1u, threads)), queues(new WorkerQueue[worker_count]) {
+        for (unsigned i = 0; i < worker_count; ++i) {
+            workers.emplace_back([this, i] { run(i); });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        work_available.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    unsigned workerCount() const { return worker_count; }
+
+    // Calls fn(i) for every i in [0, count) on the pool and returns when all
+    // calls have finished. Ranges are not split below grain items. If a call
+    // throws, items not yet started are skipped and the first exception is
+    // rethrown here once no worker still holds the job.
+    template <typename Fn>
+    void parallelFor(size_t count, size_t grain, const Fn& fn) {
+        if (count == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> submit_lock(submit_mutex);
+        Job job;
+        job.invoke = [](const void* f, size_t index) { (*static_cast<const Fn*>(f))(index); };
+        job.fn = &fn;
+        job.grain = std::max<size_t>(1, grain);
+        job.remaining.store(count, std::memory_order_relaxed);
+
+        const unsigned count_workers = workerCount();
+        for (unsigned i = 0; i < count_workers; ++i) {
+            size_t begin = count * i / count_workers;
+            size_t end = count * (i + 1) / count_workers;
+            if (begin != end) {
+                push(i, Range{&job, begin, end});
+            }
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        job_done.wait(lock, [&job] { return job.remaining.load(std::memory_order_acquire) == 0; });
+        if (job.error) {
+            std::rethrow_exception(job.error);
+        }
+    }
+};
+
+// Batch forms of validateTradeOrder and validatePortfolioRisk for offline
+// jobs; traders[i] is the trader for orders[i] / portfolios[i]
+template <typename Manager>
+void validateTradeOrdersParallel(WorkStealingPool& pool, Manager& risk_manager,
+                                 const std::vector<OrderHot>& orders,
+                                 const std::vector<const TraderProfile*>& traders,
+                                 std::vector<RiskDecision>& decisions) {
+    decisions.resize(orders.size());
+    pool.parallelFor(orders.size(), 1024, [&](size_t i) {
+        decisions[i] = risk_manager.validateTradeOrder(orders[i], *traders[i]);
+    });
+}
+
+template <typename Manager>
+void validatePortfolioRiskParallel(WorkStealingPool& pool, Manager& risk_manager,
+                                   const std::vector<std::vector<PortfolioPosition>>& portfolios,
+                                   const std::vector<const TraderProfile*>& traders,
+                                   std::vector<RiskDecision>& decisions) {
+    decisions.resize(portfolios.size());
+    pool.parallelFor(portfolios.size(), 1, [&](size_t i) {
+        decisions[i] = risk_manager.validatePortfolioRisk(portfolios[i], *traders[i]);
+    });
+}
+
+// Business Rule: Risk scoring algorithm
+inline double riskScoreOf(int experience_years, Fixed account_balance, Fixed notional,
+                          double volatility_score, Sector sector) {
+    double risk_score = 0.0;
+    
+    // Business Rule: Experience factor
+    if (experience_years < 3) {
+        risk_score += 0.3;
+    }
+    
+    // Business Rule: Account size factor
+    if (account_balance < Fixed::fromUnits(100000)) {
+        risk_score += 0.2;
+    }
+    
+    // Business Rule: Order size factor
+    if (exceedsFraction(notional, account_balance, 1, 10)) {
+        risk_score += 0.4;
+    }
+    
+    // Business Rule: Volatility factor
+    risk_score += volatility_score * 0.5;
+    
+    // Business Rule: Sector risk factor
+    if (sector == Sector::BIOTECH || sector == Sector::CRYPTO) {
+        risk_score += 0.3;
+    }
+    
+    return risk_score;
+}
+
+double calculateRiskScore(const TraderProfile& trader, const OrderHot& order) {
+    return riskScoreOf(trader.experience_years, trader.accountBalanceFx(), order.notional_fx,
+                       order.volatility_score, order.sector_code);
+}
+
+double calculateRiskScore(const TraderProfile& trader, const TradeOrder& order) {
+    return calculateRiskScore(trader, makeOrderHot(order));
+}
+
+// Inputs for scoring a batch of orders, one column per scoring factor.
+// Trader fields are copied per order so one batch can mix traders.
+struct RiskScoreColumns {
+    std::vector<int32_t> experience_years;
+    std::vector<Fixed> account_balance;
+    std::vector<Fixed> notional;
+    std::vector<double> volatility;
+    std::vector<Sector> sector;
+
+    void reserve(size_t count) {
+        experience_years.reserve(count);
+        account_balance.reserve(count);
+        notional.reserve(count);
+        volatility.reserve(count);
+        sector.reserve(count);
+    }
+
+    void clear() {
+        experience_years.clear();
+        account_balance.clear();
+        notional.clear();
+        volatility.clear();
+        sector.clear();
+    }
+
+    void add(const TraderProfile& trader, const OrderHot& order) {
+        experience_years.push_back(trader.experience_years);
+        account_balance.push_back(trader.accountBalanceFx());
+        notional.push_back(order.notional_fx);
+        volatility.push_back(order.volatility_score);
+        sector.push_back(order.sector_code);
+    }
+
+    size_t size() const { return notional.size(); }
+};
+
+inline void calculateRiskScoresScalar(const RiskScoreColumns& columns, size_t begin, double* scores) {
+    for (size_t i = begin; i < columns.size(); ++i) {
+        scores[i] = riskScoreOf(columns.experience_years[i], columns.account_balance[i], columns.notional[i],
+                                columns.volatility[i], columns.sector[i]);
+    }
+}
+
+// The vector kernels add the same constants in the same order as
+// riskScoreOf, with a masked-off lane adding +0.0 (or keeping its value),
+// so every score is bit-identical to the scalar one. AVX-512 brings FMA
+// with it, so those kernels turn contraction off to keep the volatility
+// term rounded on its own. The order-size test is exact like
+// exceedsFraction: a notional whose tenfold overflows is decided by its
+// sign alone.
+#if defined(__x86_64__) || defined(__i386__)
+constexpr int64_t kRiskScoreBalanceFloor = Fixed::fromUnits(100000).raw;
+constexpr int64_t kTenfoldMax = INT64_MAX / 10;
+constexpr int64_t kTenfoldMin = INT64_MIN / 10;
+
+__attribute__((target("avx2")))
+inline __m256d riskScore4(const RiskScoreColumns& columns, size_t i) {
+    const __m256i experience = _mm256_cvtepi32_epi64(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&columns.experience_years[i])));
+    const __m256i balance = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&columns.account_balance[i]));
+    const __m256i notional = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&columns.notional[i]));
+    int32_t sector_bytes;
+    std::memcpy(&sector_bytes, &columns.sector[i], sizeof(sector_bytes));
+    const __m256i sector = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(sector_bytes));
+
+    const __m256i novice = _mm256_cmpgt_epi64(_mm256_set1_epi64x(3), experience);
+    const __m256i small_account = _mm256_cmpgt_epi64(_mm256_set1_epi64x(kRiskScoreBalanceFloor), balance);
+    const __m256i tenfold = _mm256_add_epi64(_mm256_slli_epi64(notional, 3), _mm256_slli_epi64(notional, 1));
+    const __m256i large_order = _mm256_or_si256(
+        _mm256_cmpgt_epi64(notional, _mm256_set1_epi64x(kTenfoldMax)),
+        _mm256_andnot_si256(_mm256_cmpgt_epi64(_mm256_set1_epi64x(kTenfoldMin), notional),
+                            _mm256_cmpgt_epi64(tenfold, balance)));
+    const __m256i risky_sector = _mm256_or_si256(
+        _mm256_cmpeq_epi64(sector, _mm256_set1_epi64x(static_cast<int>(Sector::BIOTECH))),
+        _mm256_cmpeq_epi64(sector, _mm256_set1_epi64x(static_cast<int>(Sector::CRYPTO))));
+
+    // 0.0 + x is x for every x the first mask can select
+    __m256d score = _mm256_and_pd(_mm256_castsi256_pd(novice), _mm256_set1_pd(0.3));
+    score = _mm256_add_pd(score, _mm256_and_pd(_mm256_castsi256_pd(small_account), _mm256_set1_pd(0.2)));
+    score = _mm256_add_pd(score, _mm256_and_pd(_mm256_castsi256_pd(large_order), _mm256_set1_pd(0.4)));
+    score = _mm256_add_pd(score, _mm256_mul_pd(_mm256_loadu_pd(&columns.volatility[i]), _mm256_set1_pd(0.5)));
+    score = _mm256_add_pd(score, _mm256_and_pd(_mm256_castsi256_pd(risky_sector), _mm256_set1_pd(0.3)));
+    return score;
+}
+
+// Eight orders per iteration, two 4-lane registers
+__attribute__((target("avx2")))
+void calculateRiskScoresAvx2(const RiskScoreColumns& columns, double* scores) {
+    const size_t count = columns.size();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_pd(scores + i, riskScore4(columns, i));
+        _mm256_storeu_pd(scores + i + 4, riskScore4(columns, i + 4));
+    }
+    calculateRiskScoresScalar(columns, i, scores);
+}
+
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+inline __m512d riskScore8(const RiskScoreColumns& columns, size_t i) {
+    // maskz forms: the plain widening intrinsics trip -Wmaybe-uninitialized on GCC 12
+    const __m512i experience = _mm512_maskz_cvtepi32_epi64(0xFF,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&columns.experience_years[i])));
+    const __m512i balance = _mm512_loadu_si512(&columns.account_balance[i]);
+    const __m512i notional = _mm512_loadu_si512(&columns.notional[i]);
+    const __m512i sector = _mm512_maskz_cvtepu8_epi64(0xFF,
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&columns.sector[i])));
+
+    const __mmask8 novice = _mm512_cmplt_epi64_mask(experience, _mm512_set1_epi64(3));
+    const __mmask8 small_account = _mm512_cmplt_epi64_mask(balance, _mm512_set1_epi64(kRiskScoreBalanceFloor));
+    const __m512i twice = _mm512_add_epi64(notional, notional);
+    const __m512i fourfold = _mm512_add_epi64(twice, twice);
+    const __m512i tenfold = _mm512_add_epi64(_mm512_add_epi64(fourfold, fourfold), twice);
+    const __mmask8 large_order =
+        _mm512_cmpgt_epi64_mask(notional, _mm512_set1_epi64(kTenfoldMax)) |
+        _mm512_mask_cmpgt_epi64_mask(_mm512_cmpge_epi64_mask(notional, _mm512_set1_epi64(kTenfoldMin)),
+                                     tenfold, balance);
+    const __mmask8 risky_sector =
+        _mm512_cmpeq_epi64_mask(sector, _mm512_set1_epi64(static_cast<int>(Sector::BIOTECH))) |
+        _mm512_cmpeq_epi64_mask(sector, _mm512_set1_epi64(static_cast<int>(Sector::CRYPTO)));
+
+    __m512d score = _mm512_maskz_mov_pd(novice, _mm512_set1_pd(0.3));
+    score = _mm512_mask_add_pd(score, small_account, score, _mm512_set1_pd(0.2));
+    score = _mm512_mask_add_pd(score, large_order, score, _mm512_set1_pd(0.4));
+    score = _mm512_add_pd(score, _mm512_mul_pd(_mm512_loadu_pd(&columns.volatility[i]), _mm512_set1_pd(0.5)));
+    score = _mm512_mask_add_pd(score, risky_sector, score, _mm512_set1_pd(0.3));
+    return score;
+}
+
+// Sixteen orders per iteration, two 8-lane registers
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+void calculateRiskScoresAvx512(const RiskScoreColumns& columns, double* scores) {
+    const size_t count = columns.size();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_pd(scores + i, riskScore8(columns, i));
+        _mm512_storeu_pd(scores + i + 8, riskScore8(columns, i + 8));
+    }
+    calculateRiskScoresScalar(columns, i, scores);
+}
+#endif
+
+// Scores every order in the batch; scores[i] == calculateRiskScore for
+// order i, bit for bit, whichever kernel runs. A level the CPU lacks is
+// lowered to the widest one it has.
+void calculateRiskScores(const RiskScoreColumns& columns, std::vector<double>& scores,
+                         SimdLevel level = detectSimdLevel()) {
+    scores.resize(columns.size());
+    level = std::min(level, detectSimdLevel());
+#if defined(__x86_64__) || defined(__i386__)
+    if (level == SimdLevel::AVX512) {
+        calculateRiskScoresAvx512(columns, scores.data());
+        return;
+    }
+    if (level == SimdLevel::AVX2) {
+        calculateRiskScoresAvx2(columns, scores.data());
+        return;
+    }
+#endif
+    calculateRiskScoresScalar(columns, 0, scores.data());
+}
+
+// Benchmarks: run with --bench. Timings are wall-clock ns per order.
+// The benchmarks replay the same traders many times, so each accepted
+// order is cancelled straight away to hand its daily trade slot back
+template <typename Manager, typename Order>
+RiskDecision validateThenCancel(Manager& risk_manager, const Order& order, const TraderProfile& trader) {
+    RiskDecision decision = risk_manager.validateTradeOrder(order, trader);
+    if (decision) {
+        risk_manager.releaseTradeSlot(trader);
+    }
+    return decision;
+}
+
+template <typename Fn>
+double benchmarkNsPerOp(int iterations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+// Hardware event counter for the calling thread. Unavailable (reported as
+// n/a) off Linux or when perf_event_open is not permitted.
+class PerfCounter {
+private:
+    int fd = -1;
+
+    PerfCounter(uint32_t type, uint64_t config) {
+#ifdef __linux__
+        perf_event_attr attr = {};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)type;
+        (void)config;
+#endif
+    }
+
+public:
+    static PerfCounter cacheMisses() {
+#ifdef __linux__
+        return PerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#else
+        return PerfCounter(0, 0);
+#endif
+    }
+
+    static PerfCounter branchMisses() {
+#ifdef __linux__
+        return PerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#else
+        return PerfCounter(0, 0);
+#endif
+    }
+
+    PerfCounter(PerfCounter&& other) noexcept : fd(other.fd) { other.fd = -1; }
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    ~PerfCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    uint64_t stop() {
+        uint64_t count = 0;
+#ifdef __linux__
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+        return count;
+    }
+};
+
+// The categorical checks of validateTraderEligibility/validateTradeOrder as
+// they were written against the raw strings, kept as the "before" baseline
+bool stringCategoricalChecks(const TradeOrder& order, const TraderProfile& trader) {
+    bool ok = !(trader.jurisdiction() == "RESTRICTED" || trader.jurisdiction() == "SANCTIONED");
+    ok &= !(trader.riskLevel() == "HIGH" && !trader.is_accredited);
+    ok &= !(order.volatility_score > 0.8 && trader.riskLevel() == "LOW");
+    ok &= !(order.orderType() == "SHORT" && trader.traderType() == "RETAIL");
+    ok &= order.sector() != "DIVERSIFIED";
+    ok &= !(order.timeInForce() == "EXTENDED_HOURS" && trader.experience_years < 5);
+    return ok;
+}
+
+bool codedCategoricalChecks(const TradeOrder& order, const TraderProfile& trader) {
+    bool ok = !(trader.jurisdictionCode() == Jurisdiction::RESTRICTED ||
+                trader.jurisdictionCode() == Jurisdiction::SANCTIONED);
+    ok &= !(trader.riskCode() == RiskLevel::HIGH && !trader.is_accredited);
+    ok &= !(order.volatility_score > 0.8 && trader.riskCode() == RiskLevel::LOW);
+    ok &= !(order.typeCode() == OrderType::SHORT && trader.typeCode() == TraderType::RETAIL);
+    ok &= order.sectorCode() != Sector::DIVERSIFIED;
+    ok &= !(order.tifCode() == TimeInForce::EXTENDED_HOURS && trader.experience_years < 5);
+    return ok;
+}
+
+std::vector<TradeOrder> makeBenchmarkOrders(int count) {
+    static const char* types[] = {"BUY", "SELL", "SHORT", "MARKET"};
+    static const char* tifs[] = {"DAY", "GTC", "IOC", "EXTENDED_HOURS"};
+    static const char* sectors[] = {"TECHNOLOGY", "BIOTECH", "DIVERSIFIED", "CRYPTO", "ENERGY"};
+    std::vector<TradeOrder> orders;
+    orders.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        TradeOrder order = {
+            i, "SYM" + std::to_string(i % 500), types[i % 4],
+            static_cast<double>(100 + (i * 37) % 5000), 10.0 + (i * 13) % 400,
+            tifs[(i / 4) % 4], (i % 3) == 0, sectors[i % 5], ((i * 7) % 100) / 100.0
+        };
+        orders.push_back(order);
+    }
+    return orders;
+}
+
+std::vector<OrderHot> makeBenchmarkHotOrders(int count) {
+    std::vector<TradeOrder> orders = makeBenchmarkOrders(count);
+    std::vector<OrderHot> hot;
+    hot.reserve(orders.size());
+    for (const auto& order : orders) {
+        hot.push_back(makeOrderHot(order));
+    }
+    return hot;
+}
+
+void benchmarkCategoricalCodes() {
+    const int kOrders = 4096;
+    const int kIterations = 2000000;
+    std::vector<TradeOrder> orders = makeBenchmarkOrders(kOrders);
+    TraderProfile trader = {
+        123, "Bench Trader", 6, "MEDIUM", 2500000.0, 1000000.0, "RETAIL", true, "US"
+    };
+
+    volatile int sink = 0;
+    double string_ns = benchmarkNsPerOp(kIterations, [&](int i) {
+        sink += stringCategoricalChecks(orders[i & (kOrders - 1)], trader);
+    });
+    double coded_ns = benchmarkNsPerOp(kIterations, [&](int i) {
+        sink += codedCategoricalChecks(orders[i & (kOrders - 1)], trader);
+    });
+
+    TradingRiskManager risk_manager;
+    risk_manager.loginTrader(trader);
+    double validate_ns = benchmarkNsPerOp(kIterations, [&](int i) {
+        sink += validateThenCancel(risk_manager, orders[i & (kOrders - 1)], trader).accepted;
+    });
+
+    std::cout << "categorical checks, string compare: " << string_ns << " ns/order" << std::endl;
+    std::cout << "categorical checks, enum codes:     " << coded_ns << " ns/order" << std::endl;
+    std::cout << "validateTradeOrder: " << validate_ns << " ns/order" << std::endl;
+}
+
+// Prints ns/order and, when the counter is available, cache misses/order
+void reportBatchPass(const char* label, double ns_per_order, const PerfCounter& counter,
+                     uint64_t misses, size_t orders) {
+    std::cout << label << ": " << ns_per_order << " ns/order, ";
+    if (counter.available()) {
+        std::cout << static_cast<double>(misses) / orders << " cache misses/order";
+    } else {
+        std::cout << "cache misses n/a";
+    }
+    std::cout << std::endl;
+}
+
+void benchmarkHotColdBatch() {
+    const int kOrders = 1 << 19;
+    std::vector<TradeOrder> orders = makeBenchmarkOrders(kOrders);
+    OrderStore store;
+    store.reserve(orders.size());
+    for (const auto& order : orders) {
+        store.add(order);
+    }
+    TraderProfile trader = {
+        123, "Bench Trader", 6, "MEDIUM", 2500000.0, 1000000.0, "RETAIL", true, "US"
+    };
+
+    std::cout << "batch of " << kOrders << " orders, TradeOrder " << sizeof(TradeOrder)
+              << " bytes vs OrderHot " << sizeof(OrderHot) << " bytes" << std::endl;
+
+    PerfCounter counter = PerfCounter::cacheMisses();
+    volatile double score_sink = 0.0;
+    double score = 0.0;
+    counter.start();
+    double aos_ns = benchmarkNsPerOp(kOrders, [&](int i) {
+        score += calculateRiskScore(trader, orders[i]);
+    });
+    uint64_t aos_misses = counter.stop();
+    score_sink = score_sink + score;
+    reportBatchPass("calculateRiskScore over TradeOrder", aos_ns, counter, aos_misses, kOrders);
+
+    score = 0.0;
+    counter.start();
+    double hot_ns = benchmarkNsPerOp(kOrders, [&](int i) {
+        score += calculateRiskScore(trader, store[i]);
+    });
+    uint64_t hot_misses = counter.stop();
+    score_sink = score_sink + score;
+    reportBatchPass("calculateRiskScore over OrderHot  ", hot_ns, counter, hot_misses, kOrders);
+
+    TradingRiskManager risk_manager;
+    risk_manager.loginTrader(trader);
+    volatile int sink = 0;
+    counter.start();
+    double aos_validate_ns = benchmarkNsPerOp(kOrders, [&](int i) {
+        sink += validateThenCancel(risk_manager, orders[i], trader).accepted;
+    });
+    uint64_t aos_validate_misses = counter.stop();
+    counter.start();
+    double hot_validate_ns = benchmarkNsPerOp(kOrders, [&](int i) {
+        sink += validateThenCancel(risk_manager, store[i], trader).accepted;
+    });
+    uint64_t hot_validate_misses = counter.stop();
+    reportBatchPass("validateTradeOrder over TradeOrder", aos_validate_ns, counter,
+                    aos_validate_misses, kOrders);
+    reportBatchPass("validateTradeOrder over OrderHot  ", hot_validate_ns, counter,
+                    hot_validate_misses, kOrders);
+}
+
+// A mix of traders so that rejections land on different rules
+std::vector<TraderProfile> makeBenchmarkTraders() {
+    std::vector<TraderProfile> traders = {
+        {1, "Low Risk", 3, "LOW", 90000.0, 20000.0, "RETAIL", false, "US"},
+        {2, "Medium Risk", 6, "MEDIUM", 400000.0, 300000.0, "INSTITUTIONAL", true, "US"},
+        {3, "Novice", 1, "HIGH", 20000.0, 5000.0, "RETAIL", false, "NY"},
+        {4, "Prop Desk", 10, "HIGH", 5000000.0, 2000000.0, "PROPRIETARY", true, "US"},
+    };
+    return traders;
+}
+
+void benchmarkSimdRiskScore() {
+    const int kOrders = 1 << 16;
+    const int kRounds = 200;
+    std::vector<OrderHot> hot = makeBenchmarkHotOrders(kOrders);
+    std::vector<TraderProfile> traders = makeBenchmarkTraders();
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> volatility(0.0, 1.0);
+    // Notionals whose tenfold overflows, or sits right at a balance
+    const Fixed edges[] = {Fixed::max(), Fixed{-INT64_MAX}, Fixed{INT64_MAX / 10}, Fixed{INT64_MAX / 10 + 1},
+                           Fixed{INT64_MIN / 10 - 1}, Fixed::fromUnits(9000), Fixed::fromUnits(2000)};
+    RiskScoreColumns columns;
+    std::vector<double> expected;
+    // Odd count so the kernels' scalar tails run too
+    const int total = kOrders + 7;
+    columns.reserve(total);
+    expected.reserve(total);
+    for (int i = 0; i < total; ++i) {
+        OrderHot order = hot[i % kOrders];
+        order.volatility_score = volatility(rng);
+        if (rng() % 64 == 0) {
+            order.notional_fx = edges[rng() % 7];
+        }
+        const TraderProfile& trader = traders[rng() & 3];
+        columns.add(trader, order);
+        expected.push_back(calculateRiskScore(trader, order));
+    }
+
+    std::vector<double> scores;
+    double scalar_ns = 0.0;
+    for (int level = 0; level <= static_cast<int>(detectSimdLevel()); ++level) {
+        const SimdLevel simd = static_cast<SimdLevel>(level);
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round) {
+            calculateRiskScores(columns, scores, simd);
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                    (static_cast<double>(kRounds) * total);
+        if (simd == SimdLevel::SCALAR) {
+            scalar_ns = ns;
+        }
+        bool identical = std::memcmp(scores.data(), expected.data(), total * sizeof(double)) == 0;
+        std::cout << "calculateRiskScores " << simdLevelName(simd) << ": " << ns << " ns/order ("
+                  << scalar_ns / ns << "x), " << (identical ? "bit-identical" : "MISMATCH") << std::endl;
+    }
+}
+
+void benchmarkFullViolationMode() {
+    // Large enough that the branch predictor cannot learn the sequence
+    const int kOrders = 1 << 16;
+    const int kIterations = 2000000;
+    std::vector<TradeOrder> orders = makeBenchmarkOrders(kOrders);
+    std::vector<OrderHot> hot;
+    for (const auto& order : orders) {
+        hot.push_back(makeOrderHot(order));
+    }
+    TradingRiskManager risk_manager;
+    std::vector<TraderProfile> traders = makeBenchmarkTraders();
+    for (auto& trader : traders) {
+        risk_manager.loginTrader(trader);
+    }
+    // Random order/trader pairing, so the rule outcomes are not periodic
+    std::mt19937 rng(42);
+    std::vector<uint8_t> trader_of(kOrders);
+    for (auto& t : trader_of) {
+        t = static_cast<uint8_t>(rng() & 3);
+    }
+    std::shuffle(hot.begin(), hot.end(), rng);
+
+    volatile uint64_t sink = 0;
+    double first_fail_ns = benchmarkNsPerOp(kIterations, [&](int i) {
+        int k = i & (kOrders - 1);
+        sink = sink + static_cast<uint64_t>(
+            validateThenCancel(risk_manager, hot[k], traders[trader_of[k]]).reason);
+    });
+    double full_ns = benchmarkNsPerOp(kIterations, [&](int i) {
+        int k = i & (kOrders - 1);
+        sink = sink + risk_manager.evaluateTradeOrderRules(hot[k], traders[trader_of[k]]);
+    });
+    std::cout << "validateTradeOrder, first-fail mode:     " << first_fail_ns << " ns/order" << std::endl;
+    std::cout << "evaluateTradeOrderRules, all violations: " << full_ns << " ns/order ("
+              << (full_ns / first_fail_ns - 1.0) * 100.0 << "% vs first-fail)" << std::endl;
+}
+
+// The if-chain and branchless rule kernels over traders and orders whose
+// rule outcomes are independent coin flips, from a fresh trading day each
+// round so the daily limit fires too. Checks that both kernels decide
+// every eligibility and order check the same way.
+void benchmarkRuleKernels() {
+    static const char* risk_levels[] = {"LOW", "MEDIUM", "HIGH"};
+    static const char* trader_types[] = {"RETAIL", "INSTITUTIONAL", "PROPRIETARY"};
+    static const char* jurisdictions[] = {"US", "NY", "RESTRICTED", "US"};
+    static const char* types[] = {"BUY", "SELL", "SHORT", "MARKET"};
+    static const char* tifs[] = {"DAY", "GTC", "IOC", "EXTENDED_HOURS"};
+    static const char* sectors[] = {"TECHNOLOGY", "BIOTECH", "DIVERSIFIED", "CRYPTO"};
+    const int kTraders = 256;
+    const int kOrders = 1 << 16;
+    const int kRounds = 20;
+    std::mt19937 rng(25);
+
+    TradingRiskManager risk_manager;
+    std::vector<TraderProfile> traders;
+    traders.reserve(kTraders);
+    for (int t = 0; t < kTraders; ++t) {
+        TraderProfile trader = {
+            20000 + t, "Kernel Trader", static_cast<int>(rng() % 8), risk_levels[rng() % 3],
+            20000.0 + rng() % 2000000, 10000.0 + rng() % 400000, trader_types[rng() % 3],
+            (rng() & 1) != 0, jurisdictions[rng() & 3]
+        };
+        risk_manager.loginTrader(trader);
+        traders.push_back(trader);
+    }
+    std::vector<OrderHot> hot;
+    std::vector<uint8_t> trader_of;
+    hot.reserve(kOrders);
+    trader_of.reserve(kOrders);
+    for (int i = 0; i < kOrders; ++i) {
+        TradeOrder order = {
+            i, "SYM" + std::to_string(i % 500), types[rng() & 3], 100.0 + rng() % 10000,
+            10.0 + rng() % 200, tifs[rng() & 3], (rng() & 1) != 0, sectors[rng() & 3], (rng() % 100) / 100.0
+        };
+        hot.push_back(makeOrderHot(order));
+        trader_of.push_back(static_cast<uint8_t>(rng() % kTraders));
+    }
+
+    PerfCounter counter = PerfCounter::branchMisses();
+    std::vector<RiskDecision> decisions[2];
+    for (RuleKernel kernel : {RuleKernel::BRANCHING, RuleKernel::BRANCHLESS}) {
+        std::vector<RiskDecision>& out = decisions[static_cast<int>(kernel)];
+        out.resize(2 * kOrders);
+        risk_manager.setRuleKernel(kernel);
+        uint64_t misses = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round) {
+            risk_manager.resetDailyState();
+            counter.start();
+            for (int i = 0; i < kOrders; ++i) {
+                const TraderProfile& trader = traders[trader_of[i]];
+                out[2 * i] = risk_manager.validateTraderEligibility(trader);
+                out[2 * i + 1] = risk_manager.validateTradeOrder(hot[i], trader);
+            }
+            misses += counter.stop();
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                    (static_cast<double>(kRounds) * kOrders);
+        std::cout << (kernel == RuleKernel::BRANCHING ? "eligibility + order, if chain:  "
+                                                      : "eligibility + order, branchless: ")
+                  << ns << " ns/order, ";
+        if (counter.available()) {
+            std::cout << static_cast<double>(misses) / (static_cast<double>(kRounds) * kOrders)
+                      << " branch misses/order";
+        } else {
+            std::cout << "branch misses n/a";
+        }
+        std::cout << std::endl;
+    }
+    risk_manager.setRuleKernel(RuleKernel::BRANCHING);
+
+    int mismatches = 0;
+    int accepted = 0;
+    for (int i = 0; i < 2 * kOrders; ++i) {
+        const RiskDecision& a = decisions[0][i];
+        const RiskDecision& b = decisions[1][i];
+        mismatches += a.accepted != b.accepted || a.reason != b.reason || a.warnings != b.warnings;
+        accepted += a.accepted;
+    }
+    std::cout << "rule kernels: " << accepted << "/" << 2 * kOrders << " checks passed, " << mismatches
+              << " mismatches" << std::endl;
+}
+
+// validateTradeOrderBatch against one validateTradeOrder call per order,
+// over the same randomly paired orders and traders from a fresh trading
+// day; also checks that both give the same decision for every order
+void benchmarkColumnarBatch() {
+    const int kOrders = 1 << 16;
+    const int kTraders = 4096;
+    const int kRounds = 50;
+    std::vector<OrderHot> hot = makeBenchmarkHotOrders(kOrders);
+    std::vector<TraderProfile> templates = makeBenchmarkTraders();
+    TradingRiskManager risk_manager;
+    std::vector<TraderProfile> traders;
+    traders.reserve(kTraders);
+    for (int t = 0; t < kTraders; ++t) {
+        TraderProfile trader = templates[t & 3];
+        trader.trader_id = 10000 + t;
+        risk_manager.loginTrader(trader);
+        traders.push_back(trader);
+    }
+    std::vector<const TraderProfile*> table;
+    for (const auto& trader : traders) {
+        table.push_back(&trader);
+    }
+    std::mt19937 rng(7);
+    std::shuffle(hot.begin(), hot.end(), rng);
+    OrderColumns columns;
+    columns.reserve(kOrders);
+    for (const auto& order : hot) {
+        columns.add(order, rng() % kTraders);
+    }
+
+    std::vector<RejectReason> single(kOrders);
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kRounds; ++round) {
+        risk_manager.resetDailyState();
+        for (int i = 0; i < kOrders; ++i) {
+            single[i] = risk_manager.validateTradeOrder(hot[i], traders[columns.trader[i]]).reason;
+        }
+    }
+    double single_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                       (static_cast<double>(kRounds) * kOrders);
+
+    std::cout << "validateTradeOrder per order:   " << single_ns << " ns/order" << std::endl;
+
+    BatchDecisions batch;
+    for (int level = 0; level <= static_cast<int>(detectSimdLevel()); ++level) {
+        const SimdLevel simd = static_cast<SimdLevel>(level);
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round) {
+            risk_manager.resetDailyState();
+            risk_manager.validateTradeOrderBatch(columns, table, batch, simd);
+        }
+        double batch_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                          (static_cast<double>(kRounds) * kOrders);
+
+        int mismatches = 0;
+        int accepted = 0;
+        for (int i = 0; i < kOrders; ++i) {
+            mismatches += batch.reasons[i] != single[i] || batch.isAccepted(i) != (single[i] == RejectReason::NONE);
+            accepted += batch.isAccepted(i);
+        }
+        std::cout << "validateTradeOrderBatch " << simdLevelName(simd) << ": " << batch_ns << " ns/order ("
+                  << single_ns / batch_ns << "x), " << accepted << "/" << kOrders << " accepted, " << mismatches
+                  << " mismatches" << std::endl;
+    }
+}
+
+template <typename Manager>
+double benchmarkOrderValidation(Manager& risk_manager, const std::vector<OrderHot>& orders,
+                                std::vector<TraderProfile>& traders, int iterations) {
+    for (auto& trader : traders) {
+        risk_manager.loginTrader(trader);
+    }
+    const int mask = static_cast<int>(orders.size()) - 1;
+    volatile int sink = 0;
+    return benchmarkNsPerOp(iterations, [&](int i) {
+        const TraderProfile& trader = traders[(i >> 3) & 3];
+        sink += risk_manager.validateTraderEligibility(trader).accepted &
+                validateThenCancel(risk_manager, orders[i & mask], trader).accepted;
+    });
+}
+
+void benchmarkLimitsPolicies() {
+    const int kOrders = 4096;
+    const int kIterations = 2000000;
+    std::vector<TradeOrder> orders = makeBenchmarkOrders(kOrders);
+    std::vector<OrderHot> hot;
+    for (const auto& order : orders) {
+        hot.push_back(makeOrderHot(order));
+    }
+    std::vector<TraderProfile> traders = makeBenchmarkTraders();
+
+    BasicTradingRiskManager<CompiledLimitsPolicy> compiled;
+    BasicTradingRiskManager<RuntimeLimitsPolicy> runtime;
+    runtime.limitsPolicy().load(LimitSet::firmDefaults());
+    BasicTradingRiskManager<ReloadableLimitsPolicy> reloadable;
+    double compiled_ns = benchmarkOrderValidation(compiled, hot, traders, kIterations);
+    double runtime_ns = benchmarkOrderValidation(runtime, hot, traders, kIterations);
+    double reloadable_ns = benchmarkOrderValidation(reloadable, hot, traders, kIterations);
+
+    // Same loop while another thread keeps swapping MAX_ORDER_SIZE
+    std::atomic<bool> done{false};
+    uint64_t reloads = 0;
+    std::thread reloader([&] {
+        LimitSet tightened = LimitSet::firmDefaults();
+        while (!done.load(std::memory_order_relaxed)) {
+            tightened.MAX_ORDER_SIZE = Fixed::fromUnits((reloads & 1) ? 1000000 : 750000);
+            reloadable.limitsPolicy().load(tightened);
+            ++reloads;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    double reloading_ns = benchmarkOrderValidation(reloadable, hot, traders, kIterations);
+    done = true;
+    reloader.join();
+
+    std::cout << "eligibility + order, CompiledLimitsPolicy: " << compiled_ns << " ns/order" << std::endl;
+    std::cout << "eligibility + order, RuntimeLimitsPolicy:  " << runtime_ns << " ns/order" << std::endl;
+    std::cout << "eligibility + order, ReloadableLimitsPolicy: " << reloadable_ns << " ns/order" << std::endl;
+    std::cout << "eligibility + order, ReloadableLimitsPolicy under reload: " << reloading_ns
+              << " ns/order (" << reloads << " reloads)" << std::endl;
+}
+
+// count institutional traders, logged in to risk_manager
+std::vector<TraderProfile> makeLoggedInTraders(TradingRiskManager& risk_manager, int count) {
+    std::vector<TraderProfile> traders;
+    traders.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        TraderProfile trader = {
+            1000 + i, "Trader", 3 + i % 8, "MEDIUM", 250000.0 + i, 150000.0, "INSTITUTIONAL", true, "US"
+        };
+        risk_manager.loginTrader(trader);
+        traders.push_back(trader);
+    }
+    return traders;
+}
+
+int64_t percentileNs(std::vector<int64_t>& samples, double quantile) {
+    if (samples.empty()) {
+        return 0;
+    }
+    auto nth = samples.begin() + static_cast<size_t>(quantile * (samples.size() - 1));
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+}
+
+// Throughput of concurrent validateTradeOrder + checkDailyLossLimits calls
+// against one shared manager, across many traders
+void benchmarkThreadScaling() {
+    const int kTraders = 65536;
+    const int kOrders = 4096;
+    const int kOpsPerThread = 500000;
+    std::vector<OrderHot> hot = makeBenchmarkHotOrders(kOrders);
+    TradingRiskManager risk_manager;
+    std::vector<TraderProfile> traders = makeLoggedInTraders(risk_manager, kTraders);
+
+    for (int thread_count = 1; thread_count <= 32; thread_count *= 2) {
+        std::atomic<uint64_t> accepted{0};
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t] {
+                std::mt19937 rng(t + 1);
+                uint64_t local = 0;
+                for (int i = 0; i < kOpsPerThread; ++i) {
+                    const TraderProfile& trader = traders[rng() & (kTraders - 1)];
+                    local += validateThenCancel(risk_manager, hot[i & (kOrders - 1)], trader).accepted;
+                    local += risk_manager.checkDailyLossLimits(trader, 0.0).accepted;
+                }
+                accepted += local;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "threads " << thread_count << ": "
+                  << thread_count * static_cast<double>(kOpsPerThread) / seconds / 1e6
+                  << " M orders/s" << std::endl;
+    }
+}
+
+// Shared-state validators versus ShardPipeline owners, same work per order
+// (validateTradeOrder, cancel if accepted, checkDailyLossLimits). Locked
+// latency is per call; pipeline latency is gateway submit to decision,
+// so it includes time queued in the ring.
+void benchmarkShardPipeline() {
+    const int kTraders = 65536;
+    const int kOrders = 4096;
+    const int kOrdersTotal = 1000000;
+    const unsigned kValidators = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    std::vector<OrderHot> hot = makeBenchmarkHotOrders(kOrders);
+
+    struct alignas(64) LatencySamples {
+        std::vector<int64_t> ns;
+    };
+    auto report = [](const char* name, double seconds, std::vector<LatencySamples>& per_thread) {
+        std::vector<int64_t> all;
+        for (auto& samples : per_thread) {
+            all.insert(all.end(), samples.ns.begin(), samples.ns.end());
+        }
+        std::cout << name << ": " << kOrdersTotal / seconds / 1e6 << " M orders/s, p50 "
+                  << percentileNs(all, 0.50) << " ns, p99 " << percentileNs(all, 0.99) << " ns" << std::endl;
+    };
+
+    {
+        TradingRiskManager risk_manager;
+        std::vector<TraderProfile> traders = makeLoggedInTraders(risk_manager, kTraders);
+        std::vector<LatencySamples> latency(kValidators);
+        const int per_thread = kOrdersTotal / static_cast<int>(kValidators);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < kValidators; ++t) {
+            threads.emplace_back([&, t] {
+                std::mt19937 rng(t + 1);
+                std::vector<int64_t>& samples = latency[t].ns;
+                samples.reserve(2 * per_thread);
+                for (int i = 0; i < per_thread; ++i) {
+                    const TraderProfile& trader = traders[rng() & (kTraders - 1)];
+                    int64_t begin = steadyNowNs();
+                    validateThenCancel(risk_manager, hot[i & (kOrders - 1)], trader);
+                    int64_t middle = steadyNowNs();
+                    risk_manager.checkDailyLossLimits(trader, Fixed{0});
+                    samples.push_back(middle - begin);
+                    samples.push_back(steadyNowNs() - middle);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << kValidators << " shared-state validator threads" << std::endl;
+        report("  shared state, atomics", seconds, latency);
+    }
+
+    {
+        TradingRiskManager risk_manager;
+        std::vector<TraderProfile> traders = makeLoggedInTraders(risk_manager, kTraders);
+        std::vector<LatencySamples> latency(kValidators);
+        for (auto& samples : latency) {
+            samples.ns.reserve(4 * kOrdersTotal / kValidators);
+        }
+        auto on_decision = [&](unsigned worker, const PipelineRequest& request, RiskDecision decision) {
+            if (request.op == PipelineOp::VALIDATE_ORDER && decision) {
+                risk_manager.releaseTradeSlot<StateAccess::OWNER>(*request.trader);
+            }
+            latency[worker].ns.push_back(steadyNowNs() - request.submitted_ns);
+        };
+        ShardPipeline<TradingRiskManager, decltype(on_decision)> pipeline(risk_manager, kValidators, on_decision);
+        std::mt19937 rng(1);
+        auto start = std::chrono::steady_clock::now();
+        pipeline.start();
+        for (int i = 0; i < kOrdersTotal; ++i) {
+            const TraderProfile& trader = traders[rng() & (kTraders - 1)];
+            int64_t now = steadyNowNs();
+            pipeline.submit(PipelineRequest{PipelineOp::VALIDATE_ORDER, &trader, &hot[i & (kOrders - 1)], Fixed{0}, now});
+            pipeline.submit(PipelineRequest{PipelineOp::CHECK_DAILY_LOSS, &trader, nullptr, Fixed{0}, now});
+        }
+        pipeline.stop();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << pipeline.workerCount() << " shard owner threads + 1 gateway" << std::endl;
+        report("  shard pipeline, no atomics", seconds, latency);
+    }
+}
+
+// ShardPipeline run modes at a light, paced load (one request per ~200us):
+// latency from the per-thread stats, and worker CPU time per wall second
+void benchmarkValidatorRunModes() {
+    const int kTraders = 4096;
+    const int kRequests = 2000;
+    const unsigned kWorkers = 1;
+    const unsigned hardware = std::thread::hardware_concurrency();
+    std::vector<OrderHot> hot = makeBenchmarkHotOrders(1024);
+    struct Mode {
+        const char* name;
+        IdleStrategy idle;
+        bool pinned;
+    };
+    const Mode modes[] = {
+        {"yield", IdleStrategy::YIELD, false},
+        {"busy poll, pinned", IdleStrategy::BUSY_POLL, true},
+        {"poll then futex park", IdleStrategy::POLL_THEN_PARK, false},
+    };
+
+    for (const Mode& mode : modes) {
+        TradingRiskManager risk_manager;
+        std::vector<TraderProfile> traders = makeLoggedInTraders(risk_manager, kTraders);
+        auto on_decision = [&](unsigned, const PipelineRequest& request, RiskDecision decision) {
+            if (request.op == PipelineOp::VALIDATE_ORDER && decision) {
+                risk_manager.releaseTradeSlot<StateAccess::OWNER>(*request.trader);
+            }
+        };
+        PipelineConfig config;
+        config.idle = mode.idle;
+        if (mode.pinned && hardware > kWorkers) {
+            // Leave cpu 0 to the gateway; real deployments list isolated cores
+            for (unsigned cpu = 1; cpu <= kWorkers; ++cpu) {
+                config.cpus.push_back(static_cast<int>(cpu));
+            }
+        }
+        ShardPipeline<TradingRiskManager, decltype(on_decision)> pipeline(risk_manager, kWorkers, on_decision, config);
+        pipeline.start();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kRequests; ++i) {
+            const TraderProfile& trader = traders[(i * 2654435761u) & (kTraders - 1)];
+            pipeline.submit(PipelineRequest{PipelineOp::VALIDATE_ORDER, &trader, &hot[i & 1023], Fixed{0}, steadyNowNs()});
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        pipeline.stop();
+        double wall_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        for (unsigned w = 0; w < pipeline.workerCount(); ++w) {
+            const ValidatorThreadStats& stats = pipeline.threadStats(w);
+            std::cout << mode.name << (mode.pinned && config.cpus.empty() ? " (not pinned: one cpu)" : "")
+                      << ", worker " << w << ": p50 " << stats.percentileNs(0.50) << " ns, p99 "
+                      << stats.percentileNs(0.99) << " ns, max " << stats.max_ns << " ns, cpu "
+                      << 100.0 * stats.cpu_ns / wall_ns << "%, parks " << stats.parks << std::endl;
+        }
+    }
+}
+
+// Halt-to-observed latency of the firm-wide kill switch on ShardPipeline
+// workers. The gateway keeps every worker's ring fed, timestamps
+// haltTrading(), and each worker timestamps its first FIRM_KILL_SWITCH
+// rejection; the difference is how long the halt took to reach that
+// worker's validations. Repeated over several halt/resume rounds.
+void benchmarkKillSwitchPropagation() {
+    const int kTraders = 4096;
+    const int kRounds = 200;
+    const unsigned hardware = std::thread::hardware_concurrency();
+    const unsigned kWorkers = hardware > 2 ? std::min(4u, hardware - 1) : 2;
+    std::vector<OrderHot> hot = makeBenchmarkHotOrders(1024);
+    TradingRiskManager risk_manager;
+    std::vector<TraderProfile> traders = makeLoggedInTraders(risk_manager, kTraders);
+
+    struct alignas(64) FirstRejection {
+        std::atomic<int64_t> ns{0};
+    };
+    std::unique_ptr<FirstRejection[]> first_rejection(new FirstRejection[kWorkers]);
+    auto on_decision = [&](unsigned worker, const PipelineRequest& request, RiskDecision decision) {
+        if (decision) {
+            risk_manager.releaseTradeSlot<StateAccess::OWNER>(*request.trader);
+        } else if (decision.reason == RejectReason::FIRM_KILL_SWITCH &&
+                   first_rejection[worker].ns.load(std::memory_order_relaxed) == 0) {
+            first_rejection[worker].ns.store(steadyNowNs(), std::memory_order_release);
+        }
+    };
+    // Pinned busy-polling workers when there are cores to spare, as a
+    // latency-sensitive deployment would run them
+    PipelineConfig config;
+    if (hardware > kWorkers) {
+        config.idle = IdleStrategy::BUSY_POLL;
+        for (unsigned cpu = 1; cpu <= kWorkers; ++cpu) {
+            config.cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    ShardPipeline<TradingRiskManager, decltype(on_decision)> pipeline(risk_manager, kWorkers, on_decision, config);
+    const unsigned workers = pipeline.workerCount();
+
+    // One trader per worker, so a round-robin over them feeds every ring
+    std::vector<const TraderProfile*> trader_of(workers, nullptr);
+    for (const TraderProfile& trader : traders) {
+        unsigned owner = pipeline.ownerOf(trader);
+        trader_of[owner] = trader_of[owner] != nullptr ? trader_of[owner] : &trader;
+    }
+    pipeline.start();
+
+    std::vector<std::vector<int64_t>> latency(workers);
+    std::vector<int64_t> slowest;
+    int next = 0;
+    auto submitRound = [&] {
+        for (unsigned w = 0; w < workers; ++w) {
+            pipeline.submit(PipelineRequest{PipelineOp::VALIDATE_ORDER, trader_of[w], &hot[next++ & 1023], Fixed{0}, 0});
         }
-        
-        // Business Rule: Account balance requirement
-        if (trader.account_balance < MIN_ACCOUNT_BALANCE) {
-            std::cout << "REJECTED: Insufficient account balance" << std::endl;
-            return false;
+    };
+    for (int round = 0; round < kRounds; ++round) {
+        risk_manager.resumeTrading();
+        for (unsigned w = 0; w < workers; ++w) {
+            first_rejection[w].ns.store(0, std::memory_order_relaxed);
         }
-        
-        // Business Rule: Jurisdiction restrictions
-        if (trader.jurisdiction == "RESTRICTED" || trader.jurisdiction == "SANCTIONED") {
-            std::cout << "REJECTED: Trader from restricted jurisdiction" << std::endl;
-            return false;
+        for (int i = 0; i < 64; ++i) {
+            submitRound();
         }
-        
-        // Business Rule: Accreditation requirement for high-risk trading
-        if (trader.risk_level == "HIGH" && !trader.is_accredited) {
-            std::cout << "REJECTED: High-risk trading requires accreditation" << std::endl;
-            return false;
+        const int64_t tripped_ns = steadyNowNs();
+        risk_manager.haltTrading();
+        for (unsigned seen = 0; seen < workers;) {
+            submitRound();
+            if (config.cpus.empty()) {
+                // Workers share the gateway's cpu: let them run
+                std::this_thread::yield();
+            }
+            seen = 0;
+            for (unsigned w = 0; w < workers; ++w) {
+                seen += first_rejection[w].ns.load(std::memory_order_acquire) != 0;
+            }
         }
-        
-        // Business Rule: Pattern Day Trader rule compliance
-        if (trader.trader_type == "RETAIL" && trader.account_balance < PATTERN_DAY_TRADER_LIMIT) {
-            std::cout << "WARNING: Pattern Day Trader restrictions apply" << std::endl;
+        int64_t round_max = 0;
+        for (unsigned w = 0; w < workers; ++w) {
+            int64_t delay = first_rejection[w].ns.load(std::memory_order_relaxed) - tripped_ns;
+            latency[w].push_back(delay);
+            round_max = std::max(round_max, delay);
         }
-        
-        return true;
+        slowest.push_back(round_max);
     }
-    
-    // Business Rule: Validate individual trade order
-    bool validateTradeOrder(const TradeOrder& order, const TraderProfile& trader) {
-        // Business Rule: Maximum order size limit
-        double order_value = order.quantity * order.price;
-        if (order_value > MAX_ORDER_SIZE) {
-            std::cout << "REJECTED: Order size exceeds maximum allowed" << std::endl;
-            return false;
+    pipeline.stop();
+    risk_manager.resumeTrading();
+
+    const char* mode = config.cpus.empty() ? "yielding workers (too few cpus to pin)" : "pinned busy-polling workers";
+    std::cout << "kill switch halt to first rejection, " << workers << " " << mode << ", " << kRounds
+              << " rounds" << std::endl;
+    for (unsigned w = 0; w < workers; ++w) {
+        std::cout << "  worker " << w << ": p50 " << percentileNs(latency[w], 0.50) << " ns, p99 "
+                  << percentileNs(latency[w], 0.99) << " ns" << std::endl;
+    }
+    std::cout << "  all workers: p50 " << percentileNs(slowest, 0.50) << " ns, p99 " << percentileNs(slowest, 0.99)
+              << " ns, max " << percentileNs(slowest, 1.0) << " ns" << std::endl;
+}
+
+// Portfolios with a heavy-tailed size distribution: 1% of accounts hold
+// 32768 positions, 9% hold 2048, the rest 64. The large accounts come
+// first, as they would in a book sorted by account tier.
+std::vector<std::vector<PortfolioPosition>> makeSkewedPortfolios(int count) {
+    static const char* categories[] = {"LOW_RISK", "MEDIUM_RISK", "HIGH_RISK"};
+    std::vector<std::vector<PortfolioPosition>> portfolios(count);
+    for (int p = 0; p < count; ++p) {
+        int size = p < count / 100 ? 32768 : p < count / 10 ? 2048 : 64;
+        portfolios[p].reserve(size);
+        for (int i = 0; i < size; ++i) {
+            PortfolioPosition position = {
+                "SYM" + std::to_string(i % 500), 1000.0 + (i * 37) % 9000,
+                ((i * 13) % 200) - 120.0, 0.05, categories[i % 3]
+            };
+            ingestPortfolioPosition(position);
+            portfolios[p].push_back(position);
         }
-        
-        // Business Rule: Volatility-based restrictions
-        if (order.volatility_score > 0.8 && trader.risk_level == "LOW") {
-            std::cout << "REJECTED: High volatility instrument not allowed for low-risk trader" << std::endl;
-            return false;
+    }
+    return portfolios;
+}
+
+// validatePortfolioRisk over skewed portfolios: one thread, contiguous
+// static partitions per thread, and the work-stealing pool
+void benchmarkWorkStealingBatch() {
+    const int kPortfolios = 1000;
+    const int kRounds = 5;
+    const unsigned kThreads = std::max(4u, std::thread::hardware_concurrency());
+    std::vector<std::vector<PortfolioPosition>> portfolios = makeSkewedPortfolios(kPortfolios);
+    TraderProfile trader = {
+        77, "Book Trader", 10, "MEDIUM", 50000000.0, 20000000.0, "INSTITUTIONAL", true, "US"
+    };
+    std::vector<const TraderProfile*> traders(kPortfolios, &trader);
+    TradingRiskManager risk_manager;
+    std::vector<RiskDecision> decisions(kPortfolios);
+
+    auto timeRounds = [&](auto&& body) {
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round) {
+            body();
         }
-        
-        // Business Rule: Short selling restrictions
-        if (order.order_type == "SHORT") {
-            if (trader.trader_type == "RETAIL" && order_value > 100000.0) {
-                std::cout << "REJECTED: Large short positions restricted for retail traders" << std::endl;
-                return false;
-            }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kRounds;
+    };
+
+    double sequential_ms = timeRounds([&] {
+        for (int i = 0; i < kPortfolios; ++i) {
+            decisions[i] = risk_manager.validatePortfolioRisk(portfolios[i], trader);
         }
-        
-        // Business Rule: Margin trading eligibility
-        if (order.is_margin_trade) {
-            if (trader.available_margin < order_value * 0.5) {
-                std::cout << "REJECTED: Insufficient margin for trade" << std::endl;
-                return false;
-            }
+    });
+    double static_ms = timeRounds([&] {
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = kPortfolios * t / kThreads; i < static_cast<int>(kPortfolios * (t + 1) / kThreads); ++i) {
+                    decisions[i] = risk_manager.validatePortfolioRisk(portfolios[i], trader);
+                }
+            });
         }
-        
-        // Business Rule: Daily trade limit
-        if (daily_trade_counts[trader.trader_id] >= MAX_TRADES_PER_DAY) {
-            std::cout << "REJECTED: Daily trade limit exceeded" << std::endl;
-            return false;
+        for (auto& thread : threads) {
+            thread.join();
         }
-        
-        // Business Rule: Sector concentration limits
-        if (order.sector != "DIVERSIFIED") {
-            // This would check against portfolio positions in real implementation
-            std::cout << "INFO: Checking sector concentration limits" << std::endl;
+    });
+    WorkStealingPool pool(kThreads);
+    double stealing_ms = timeRounds([&] {
+        validatePortfolioRiskParallel(pool, risk_manager, portfolios, traders, decisions);
+    });
+
+    std::cout << "skewed portfolios, " << kThreads << " threads: sequential " << sequential_ms
+              << " ms, static partition " << static_ms << " ms, work stealing " << stealing_ms
+              << " ms" << std::endl;
+}
+
+std::vector<PortfolioPosition> makeBenchmarkPortfolio(int size) {
+    static const char* categories[] = {"LOW_RISK", "MEDIUM_RISK", "HIGH_RISK", "MEDIUM_RISK"};
+    std::mt19937 rng(size);
+    std::uniform_real_distribution<double> value(1000.0, 100000.0);
+    std::uniform_real_distribution<double> pnl(-5000.0, 4000.0);
+    std::vector<PortfolioPosition> positions;
+    positions.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        PortfolioPosition position = {
+            "SYM" + std::to_string(i % 500), value(rng), pnl(rng), 0.05, categories[rng() & 3]
+        };
+        ingestPortfolioPosition(position);
+        positions.push_back(position);
+    }
+    return positions;
+}
+
+// validatePortfolioRisk as it was before the fused pass: totals first,
+// then a second walk for the position size and concentration rules.
+// Kept as the reference for --portfolio-check and the benchmark.
+RiskDecision twoPassPortfolioRisk(const std::vector<PortfolioPosition>& positions, const TraderProfile& trader) {
+    uint16_t warnings = 0;
+    double total_portfolio_value = 0.0;
+    double total_unrealized_loss = 0.0;
+    double high_risk_exposure = 0.0;
+    for (const auto& position : positions) {
+        total_portfolio_value += position.current_value;
+        if (position.unrealized_pnl < 0) {
+            total_unrealized_loss += std::fabs(position.unrealized_pnl);
         }
-        
-        // Business Rule: After-hours trading restrictions
-        if (order.time_in_force == "EXTENDED_HOURS" && trader.experience_years < 5) {
-            std::cout << "REJECTED: Insufficient experience for after-hours trading" << std::endl;
-            return false;
+        if (position.risk_category == "HIGH_RISK") {
+            high_risk_exposure += position.current_value;
         }
-        
-        return true;
     }
-    
-    // Business Rule: Portfolio risk assessment
-    bool validatePortfolioRisk(const std::vector<PortfolioPosition>& positions, 
-                              const TraderProfile& trader) {
-        double total_portfolio_value = 0.0;
-        double total_unrealized_loss = 0.0;
-        double high_risk_exposure = 0.0;
-        
-        // Business Rule: Calculate portfolio metrics
-        for (const auto& position : positions) {
-            total_portfolio_value += position.current_value;
-            
-            if (position.unrealized_pnl < 0) {
-                total_unrealized_loss += abs(position.unrealized_pnl);
-            }
-            
-            if (position.risk_category == "HIGH_RISK") {
-                high_risk_exposure += position.current_value;
-            }
+    if (total_unrealized_loss > trader.accountBalance() * 0.20) {
+        warnings |= WARN_PORTFOLIO_LOSS;
+    }
+    for (const auto& position : positions) {
+        if (position.current_value > FirmLimits::MAX_POSITION_SIZE) {
+            return RiskDecision::reject(RejectReason::POSITION_SIZE_LIMIT, warnings);
         }
-        
-        // Business Rule: Maximum portfolio loss limit
-        if (total_unrealized_loss > trader.account_balance * 0.20) {
-            std::cout << "WARNING: Portfolio losses exceed 20% of account balance" << std::endl;
+        if (position.current_value > total_portfolio_value * 0.20) {
+            warnings |= WARN_POSITION_CONCENTRATION;
         }
-        
-        // Business Rule: Position size limits
+    }
+    if (high_risk_exposure > total_portfolio_value * FirmLimits::HIGH_RISK_THRESHOLD) {
+        return RiskDecision::reject(RejectReason::HIGH_RISK_EXPOSURE, warnings);
+    }
+    double leverage_ratio = total_portfolio_value / trader.accountBalance();
+    if (leverage_ratio > FirmLimits::MAX_LEVERAGE_RATIO) {
+        return RiskDecision::reject(RejectReason::LEVERAGE_LIMIT, warnings);
+    }
+    double margin_equity_ratio = trader.accountBalance() / total_portfolio_value;
+    if (margin_equity_ratio < FirmLimits::MARGIN_CALL_THRESHOLD) {
+        warnings |= WARN_MARGIN_CALL;
+    }
+    if (margin_equity_ratio < FirmLimits::FORCED_LIQUIDATION) {
+        return RiskDecision::reject(RejectReason::FORCED_LIQUIDATION, warnings);
+    }
+    return RiskDecision::accept(warnings);
+}
+
+bool sameDecision(const RiskDecision& a, const RiskDecision& b) {
+    return a.accepted == b.accepted && a.reason == b.reason && a.warnings == b.warnings;
+}
+
+// Two-pass reference against the fused validatePortfolioRisk
+void benchmarkFusedPortfolioRisk() {
+    TradingRiskManager risk_manager;
+    for (int size : {100, 10000, 1000000}) {
+        std::vector<PortfolioPosition> positions = makeBenchmarkPortfolio(size);
+        TraderProfile trader = makeBenchmarkTraders()[3];
+        trader.setAccountBalance(size * 30000.0);
+
+        const int rounds = std::max(1, (1 << 23) / size);
+        volatile int sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            sink += twoPassPortfolioRisk(positions, trader).accepted;
+        }
+        double two_pass_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                             (static_cast<double>(rounds) * size);
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            sink += risk_manager.validatePortfolioRisk(positions, trader).accepted;
+        }
+        double fused_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                          (static_cast<double>(rounds) * size);
+        bool same = sameDecision(risk_manager.validatePortfolioRisk(positions, trader),
+                                 twoPassPortfolioRisk(positions, trader));
+        std::cout << size << " positions, validatePortfolioRisk two-pass: " << two_pass_ns << " ns/position, fused: "
+                  << fused_ns << " ns/position (" << 1e3 / fused_ns << " M positions/s), "
+                  << (same ? "same decision" : "DECISION DIFFERS") << std::endl;
+    }
+}
+
+// validatePortfolioRisk over the AoS positions against the PortfolioStore
+// overload at each SIMD level, on one large portfolio at a time
+void benchmarkPortfolioStore() {
+    TradingRiskManager risk_manager;
+    for (int size : {16384, 1 << 20}) {
+        std::vector<PortfolioPosition> positions = makeBenchmarkPortfolio(size);
+        PortfolioStore store;
+        store.reserve(size);
         for (const auto& position : positions) {
-            if (position.current_value > MAX_POSITION_SIZE) {
-                std::cout << "VIOLATION: Position size exceeds maximum allowed" << std::endl;
-                return false;
+            store.add(position);
+        }
+        // Sized so the portfolio sits well inside the leverage and margin rules
+        TraderProfile trader = makeBenchmarkTraders()[3];
+        double total = 0.0;
+        for (const auto& position : positions) {
+            total += position.current_value;
+        }
+        trader.setAccountBalance(total / 2);
+
+        const int rounds = std::max(1, (1 << 23) / size);
+        volatile int sink = 0;
+        RiskDecision expected = risk_manager.validatePortfolioRisk(positions, trader);
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            sink += risk_manager.validatePortfolioRisk(positions, trader).accepted;
+        }
+        double aos_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                        (static_cast<double>(rounds) * size);
+        std::cout << size << " positions, validatePortfolioRisk over PortfolioPosition: " << aos_ns
+                  << " ns/position" << std::endl;
+
+        for (int level = 0; level <= static_cast<int>(detectSimdLevel()); ++level) {
+            const SimdLevel simd = static_cast<SimdLevel>(level);
+            RiskDecision decision = risk_manager.validatePortfolioRisk(store, trader, simd);
+            start = std::chrono::steady_clock::now();
+            for (int round = 0; round < rounds; ++round) {
+                sink += risk_manager.validatePortfolioRisk(store, trader, simd).accepted;
+            }
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                        (static_cast<double>(rounds) * size);
+            bool same = decision.accepted == expected.accepted && decision.reason == expected.reason &&
+                        decision.warnings == expected.warnings;
+            std::cout << size << " positions, PortfolioStore " << simdLevelName(simd) << ": " << ns
+                      << " ns/position (" << aos_ns / ns << "x), " << (same ? "same decision" : "DECISION DIFFERS")
+                      << std::endl;
+        }
+    }
+}
+
+int runBenchmarks() {
+    benchmarkCategoricalCodes();
+    benchmarkHotColdBatch();
+    benchmarkSimdRiskScore();
+    benchmarkFullViolationMode();
+    benchmarkRuleKernels();
+    benchmarkColumnarBatch();
+    benchmarkLimitsPolicies();
+    benchmarkThreadScaling();
+    benchmarkShardPipeline();
+    benchmarkValidatorRunModes();
+    benchmarkKillSwitchPropagation();
+    benchmarkWorkStealingBatch();
+    benchmarkPortfolioStore();
+    benchmarkFusedPortfolioRisk();
+    return 0;
+}
+
+// Self-test: after warmup, a million orders through the pre-trade path
+// must not touch the global allocator. Returns non-zero on failure.
+int runAllocationCheck() {
+#ifdef RISK_ALLOCATION_CHECK
+    const int kOrders = 4096;
+    const int kRuns = 1000000;
+    std::vector<TradeOrder> orders = makeBenchmarkOrders(kOrders);
+    std::vector<OrderHot> hot;
+    hot.reserve(orders.size());
+    for (const auto& order : orders) {
+        hot.push_back(makeOrderHot(order));
+    }
+    std::vector<TraderProfile> traders = makeBenchmarkTraders();
+    TradingRiskManager risk_manager;
+    for (auto& trader : traders) {
+        risk_manager.loginTrader(trader);
+    }
+
+    uint64_t accepted = 0;
+    auto validate = [&](int i) {
+        const TraderProfile& trader = traders[i & 3];
+        const int k = i & (kOrders - 1);
+        accepted += risk_manager.validateTraderEligibility(trader).accepted;
+        accepted += validateThenCancel(risk_manager, hot[k], trader).accepted;
+        accepted += validateThenCancel(risk_manager, orders[k], trader).accepted;
+        accepted += risk_manager.evaluateTradeOrderRules(hot[k], trader) == 0;
+        accepted += risk_manager.evaluateTradeOrderRules(orders[k], trader) == 0;
+        accepted += risk_manager.assessClientSuitability(trader, ProductType::DERIVATIVES).accepted;
+        accepted += risk_manager.checkDailyLossLimits(trader, 0.0).accepted;
+        accepted += calculateRiskScore(trader, hot[k]) < 1.0;
+        accepted += calculateRiskScore(trader, orders[k]) < 1.0;
+    };
+    for (int i = 0; i < kOrders; ++i) {
+        validate(i);
+    }
+
+    uint64_t before = allocation_count.load();
+    for (int i = 0; i < kRuns; ++i) {
+        validate(i);
+    }
+    uint64_t allocations = allocation_count.load() - before;
+    if (allocations != 0) {
+        std::cout << "allocation check FAILED: " << allocations << " allocations over "
+                  << kRuns << " orders" << std::endl;
+        return 1;
+    }
+    std::cout << "allocation check passed: 0 allocations over " << kRuns << " orders ("
+              << accepted << " accepting checks)" << std::endl;
+    return 0;
+#else
+    std::cout << "allocation check needs a build with -DRISK_ALLOCATION_CHECK" << std::endl;
+    return 2;
+#endif
+}
+
+// Self-test: the fused validatePortfolioRisk, and the PortfolioStore
+// overload at the scalar level, must decide exactly as the two-pass
+// reference on randomized portfolios, including empty ones, oversized,
+// negative and NaN positions; evaluatePortfolioRiskRules must agree with
+// it. Returns non-zero on failure.
+int runPortfolioCheck() {
+    static const char* categories[] = {"HIGH_RISK", "LOW_RISK", "MEDIUM_RISK"};
+    const int kPortfolios = 200000;
+    TradingRiskManager risk_manager;
+    std::vector<TraderProfile> traders = makeBenchmarkTraders();
+    std::mt19937 rng(24);
+    std::vector<PortfolioPosition> positions;
+    PortfolioStore store;
+    int mismatches = 0;
+    int rejected = 0;
+    for (int p = 0; p < kPortfolios; ++p) {
+        positions.clear();
+        store.clear();
+        const int size = rng() % 48;
+        for (int i = 0; i < size; ++i) {
+            double value;
+            switch (rng() % 8) {
+                case 0: value = FirmLimits::MAX_POSITION_SIZE + (rng() % 3) - 1.0; break;
+                case 1: value = -static_cast<double>(rng() % 50000); break;
+                case 2: value = (rng() % 4) * 25000.0; break;
+                default: value = (rng() % 1000000) / 3.0; break;
             }
-            
-            // Business Rule: Single position concentration limit
-            if (position.current_value > total_portfolio_value * 0.20) {
-                std::cout << "WARNING: Single position exceeds 20% of portfolio" << std::endl;
+            if (rng() % 512 == 0) {
+                value = std::nan("");
             }
+            PortfolioPosition position = {
+                "SYM", value, (static_cast<int>(rng() % 200000) - 150000) / 7.0, 0.05, categories[rng() % 3]
+            };
+            ingestPortfolioPosition(position);
+            positions.push_back(position);
+            store.add(position);
         }
-        
-        // Business Rule: High-risk exposure limits
-        if (high_risk_exposure > total_portfolio_value * HIGH_RISK_THRESHOLD) {
-            std::cout << "VIOLATION: High-risk exposure exceeds threshold" << std::endl;
-            return false;
+        const TraderProfile& trader = traders[rng() & 3];
+        RiskDecision expected = twoPassPortfolioRisk(positions, trader);
+        rejected += !expected.accepted;
+        mismatches += !sameDecision(risk_manager.validatePortfolioRisk(positions, trader), expected);
+        mismatches += !sameDecision(risk_manager.validatePortfolioRisk(store, trader, SimdLevel::SCALAR), expected);
+        // Full-violation mode: the lowest rule bit is the first-fail reason,
+        // and an accepted portfolio carries the same warnings
+        uint64_t mask = risk_manager.evaluatePortfolioRiskRules(positions, trader);
+        mismatches += firstViolation(mask) != expected.reason;
+        mismatches += expected.accepted && static_cast<uint16_t>(mask >> 32) != expected.warnings;
+    }
+    if (mismatches != 0) {
+        std::cout << "portfolio check FAILED: " << mismatches << " decisions differ from the two-pass reference"
+                  << std::endl;
+        return 1;
+    }
+    std::cout << "portfolio check passed: " << kPortfolios << " portfolios (" << rejected
+              << " rejected) decided as by the two-pass reference" << std::endl;
+    return 0;
+}
+
+// Starts fn(t) on threads 0..count-1 behind a common start gate, so the
+// threads hit shared state together, and joins them
+template <typename Fn>
+void runConcurrently(unsigned count, Fn&& fn) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < count; ++t) {
+        threads.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            fn(t);
+        });
+    }
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Self-test: a manager sized for N traders must take exactly N random ids
+// logged in at once, each to its own slot; WorkStealingPool must hand an
+// exception from a job back to its caller and stay usable; a batch order
+// whose trader index is past the table must be rejected; SHARED
+// validators racing on one trader must never accept more than
+// MAX_TRADES_PER_DAY orders between them, under either rule kernel or the
+// batch path; report each daily loss crossing exactly once; and, once a
+// kill switch has been engaged, reject every later order. Returns non-zero
+// on failure.
+int runConcurrencyCheck() {
+    const unsigned kThreads = 8;
+    const int kRounds = 100;
+    const int kAttempts = 40;  // per thread; kThreads * kAttempts > MAX_TRADES_PER_DAY
+    const int kLossCalls = 100;
+    const Fixed kLossStep = Fixed::fromUnits(1000);
+    const int kKillIterations = 200;  // per thread, after the switch is seen
+
+    TraderProfile trader = {7, "Racer", 5, "MEDIUM", 250000.0, 100000.0, "RETAIL", true, "US"};
+    TradeOrder order = {1, "AAPL", "BUY", 1000, 150.0, "DAY", false, "TECHNOLOGY", 0.3};
+    const OrderHot hot = makeOrderHot(order);
+    TradingRiskManager risk_manager;
+    risk_manager.loginTrader(trader);
+
+    int failures = 0;
+    auto fail = [&](const char* what, int round) {
+        if (failures++ < 8) {
+            std::cout << "concurrency check: " << what << " (round " << round << ")" << std::endl;
         }
-        
-        // Business Rule: Leverage ratio check
-        double leverage_ratio = total_portfolio_value / trader.account_balance;
-        if (leverage_ratio > MAX_LEVERAGE_RATIO) {
-            std::cout << "VIOLATION: Leverage ratio exceeds maximum allowed" << std::endl;
-            return false;
+    };
+
+    // Logins: however the ids hash across shards, a full-sized set fits
+    std::mt19937 rng(17);
+    for (size_t capacity : {1, 3, 64, 1000, 5000}) {
+        TradingRiskManager sized(capacity);
+        std::vector<TraderProfile> logins;
+        std::vector<int> ids;
+        while (ids.size() < capacity) {
+            int id = static_cast<int>(rng());
+            if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+                ids.push_back(id);
+                logins.push_back(trader);
+                logins.back().trader_id = id;
+            }
         }
-        
-        // Business Rule: Margin call assessment
-        double margin_equity_ratio = trader.account_balance / total_portfolio_value;
-        if (margin_equity_ratio < MARGIN_CALL_THRESHOLD) {
-            std::cout << "MARGIN CALL: Account below margin maintenance requirement" << std::endl;
+        runConcurrently(kThreads, [&](unsigned t) {
+            for (size_t i = t; i < capacity; i += kThreads) {
+                sized.loginTrader(logins[i]);
+            }
+        });
+        std::vector<uint32_t> slots;
+        for (auto& login : logins) {
+            slots.push_back(login.state_slot);
+            if (login.state_slot == TraderStateTable::INVALID_SLOT ||
+                sized.loginTrader(login) != slots.back() ||
+                sized.checkDailyLossLimits(login.trader_id, 0.0).reason == RejectReason::TRADER_CAPACITY_EXCEEDED) {
+                fail("trader not given a findable slot in a table sized for it", static_cast<int>(capacity));
+                break;
+            }
         }
-        
-        // Business Rule: Forced liquidation trigger
-        if (margin_equity_ratio < FORCED_LIQUIDATION) {
-            std::cout << "FORCED LIQUIDATION: Account below liquidation threshold" << std::endl;
-            return false;
+        std::sort(slots.begin(), slots.end());
+        if (std::adjacent_find(slots.begin(), slots.end()) != slots.end()) {
+            fail("two traders given the same slot", static_cast<int>(capacity));
         }
-        
-        return true;
     }
-    
-    // Business Rule: Market condition restrictions
-    bool checkMarketConditions(double current_vix, const std::string& market_status) {
-        // Business Rule: VIX-based trading halts
-        if (current_vix > VIX_HALT_THRESHOLD) {
-            std::cout << "TRADING HALT: Market volatility too high (VIX > 40)" << std::endl;
-            return false;
+
+    // Batch pool: a throwing call reaches the parallelFor caller once the
+    // job is done, and the pool runs the next job in full
+    WorkStealingPool pool(kThreads);
+    const size_t kItems = 10000;
+    for (int round = 0; round < kRounds; ++round) {
+        const size_t thrower = rng() % kItems;
+        bool caught = false;
+        try {
+            pool.parallelFor(kItems, 16, [&](size_t i) {
+                if (i == thrower) {
+                    throw std::runtime_error("item failed");
+                }
+            });
+        } catch (const std::runtime_error&) {
+            caught = true;
         }
-        
-        // Business Rule: Market hours validation
-        if (market_status == "CLOSED") {
-            std::cout << "REJECTED: Market is closed for regular trading" << std::endl;
-            return false;
+        std::atomic<size_t> sum{0};
+        pool.parallelFor(kItems, 16, [&](size_t i) { sum.fetch_add(i, std::memory_order_relaxed); });
+        if (!caught) {
+            fail("exception from a pool job not rethrown to its caller", round);
         }
-        
-        // Business Rule: Pre-market restrictions
-        if (market_status == "PRE_MARKET") {
-            std::cout << "RESTRICTED: Limited pre-market trading allowed" << std::endl;
+        if (sum.load() != kItems * (kItems - 1) / 2) {
+            fail("pool job after a failed one skipped items", round);
         }
-        
-        return true;
     }
-    
-    // Business Rule: Daily loss monitoring
-    bool checkDailyLossLimits(int trader_id, double trade_loss) {
-        daily_losses[trader_id] += trade_loss;
-        
-        // Business Rule: Daily loss limit enforcement
-        if (daily_losses[trader_id] > MAX_DAILY_LOSS) {
-            std::cout << "TRADING SUSPENDED: Daily loss limit exceeded" << std::endl;
-            return false;
+
+    // Batch: an order whose trader index is past the table is rejected at
+    // every level, however large the index, and the other orders are
+    // decided as in a batch without it
+    {
+        TradingRiskManager checker;
+        TraderProfile batch_trader = trader;
+        checker.loginTrader(batch_trader);
+        const std::vector<const TraderProfile*> table = {&batch_trader};
+        const uint32_t indices[] = {0, 1, 2, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFFu};
+        OrderColumns mixed;
+        OrderColumns valid;
+        for (int i = 0; i < 64; ++i) {
+            mixed.add(hot, indices[i % 6]);
+            if (i % 6 == 0) {
+                valid.add(hot, 0);
+            }
         }
-        
-        // Business Rule: Warning at 75% of daily limit
-        if (daily_losses[trader_id] > MAX_DAILY_LOSS * 0.75) {
-            std::cout << "WARNING: Approaching daily loss limit" << std::endl;
+        BatchDecisions with_bad;
+        BatchDecisions without;
+        for (int level = 0; level <= static_cast<int>(detectSimdLevel()); ++level) {
+            checker.resetDailyState();
+            checker.validateTradeOrderBatch(mixed, table, with_bad, static_cast<SimdLevel>(level));
+            checker.resetDailyState();
+            checker.validateTradeOrderBatch(valid, table, without, static_cast<SimdLevel>(level));
+            for (size_t i = 0; i < mixed.size(); ++i) {
+                const bool bad = i % 6 != 0;
+                if (bad ? with_bad.isAccepted(i) || with_bad.reasons[i] != RejectReason::TRADER_CAPACITY_EXCEEDED
+                        : with_bad.reasons[i] != without.reasons[i / 6]) {
+                    fail("batch order with a trader index past the table misjudged", level);
+                    break;
+                }
+            }
         }
-        
-        return true;
     }
-    
-    // Business Rule: Client suitability assessment
-    bool assessClientSuitability(const TraderProfile& trader, const std::string& product_type) {
-        // Business Rule: Complex products require institutional status
-        if (product_type == "DERIVATIVES" || product_type == "STRUCTURED_PRODUCTS") {
-            if (trader.trader_type == "RETAIL" && !trader.is_accredited) {
-                std::cout << "REJECTED: Complex products require accredited investor status" << std::endl;
-                return false;
+
+    for (int round = 0; round < kRounds; ++round) {
+        risk_manager.setRuleKernel(round & 1 ? RuleKernel::BRANCHLESS : RuleKernel::BRANCHING);
+        risk_manager.resetDailyState();
+
+        // Daily trade limit: never overshoot, and every rejection is the limit
+        std::atomic<int> accepted{0};
+        std::atomic<int> wrong_reason{0};
+        runConcurrently(kThreads, [&](unsigned t) {
+            OrderColumns columns;
+            columns.add(hot, 0);
+            const std::vector<const TraderProfile*> batch_traders = {&trader};
+            BatchDecisions batch;
+            for (int i = 0; i < kAttempts; ++i) {
+                bool ok;
+                RejectReason reason;
+                if (t % 2 == 0) {
+                    RiskDecision decision = risk_manager.validateTradeOrder(hot, trader);
+                    ok = decision.accepted;
+                    reason = decision.reason;
+                } else {
+                    risk_manager.validateTradeOrderBatch(columns, batch_traders, batch);
+                    ok = batch.isAccepted(0);
+                    reason = batch.reasons[0];
+                }
+                if (ok) {
+                    risk_manager.commitTradeSlot(trader);
+                    accepted.fetch_add(1, std::memory_order_relaxed);
+                } else if (reason != RejectReason::DAILY_TRADE_LIMIT) {
+                    wrong_reason.fetch_add(1, std::memory_order_relaxed);
+                }
             }
+        });
+        if (accepted.load() != FirmLimits::MAX_TRADES_PER_DAY ||
+            risk_manager.filledTradesToday(trader) != FirmLimits::MAX_TRADES_PER_DAY) {
+            fail("daily trade limit overshot or undershot", round);
         }
-        
-        // Business Rule: High-frequency trading restrictions
-        if (product_type == "HFT_ALGORITHMS") {
-            if (trader.trader_type != "PROPRIETARY") {
-                std::cout << "REJECTED: HFT algorithms restricted to proprietary traders" << std::endl;
-                return false;
-            }
+        if (wrong_reason.load() != 0) {
+            fail("order rejected for a reason other than the daily trade limit", round);
         }
-        
-        // Business Rule: International trading requirements
-        if (product_type == "INTERNATIONAL_EQUITIES") {
-            if (trader.experience_years < 5) {
-                std::cout << "REJECTED: International trading requires 5+ years experience" << std::endl;
-                return false;
+
+        // Daily loss: each crossing is reported by exactly one caller
+        std::atomic<int> warning_events{0};
+        std::atomic<int> limit_events{0};
+        runConcurrently(kThreads, [&](unsigned) {
+            for (int i = 0; i < kLossCalls; ++i) {
+                RiskDecision decision = risk_manager.checkDailyLossLimits(trader, kLossStep);
+                warning_events.fetch_add((decision.warnings & WARN_DAILY_LOSS_75_CROSSED) != 0,
+                                         std::memory_order_relaxed);
+                limit_events.fetch_add((decision.warnings & WARN_DAILY_LOSS_LIMIT_CROSSED) != 0,
+                                       std::memory_order_relaxed);
             }
+        });
+        if (warning_events.load() != 1 || limit_events.load() != 1) {
+            fail("daily loss crossing not reported exactly once", round);
         }
-        
-        // Business Rule: Cryptocurrency trading restrictions
-        if (product_type == "CRYPTOCURRENCY") {
-            if (trader.jurisdiction == "NY" || trader.jurisdiction == "RESTRICTED_CRYPTO") {
-                std::cout << "REJECTED: Cryptocurrency trading not allowed in jurisdiction" << std::endl;
-                return false;
+        // The limit breach suspended the trader exactly once
+        risk_manager.resetDailyState();
+        if (risk_manager.validateTradeOrder(hot, trader).reason != RejectReason::TRADER_SUSPENDED ||
+            !risk_manager.resumeTrader(trader)) {
+            fail("daily loss breach did not suspend the trader", round);
+        }
+
+        // Kill switches: after the switch is published, every validator's
+        // next order is rejected
+        for (int kind = 0; kind < 2; ++kind) {
+            const RejectReason expected = kind == 0 ? RejectReason::FIRM_KILL_SWITCH : RejectReason::TRADER_SUSPENDED;
+            std::atomic<bool> engaged{false};
+            std::atomic<unsigned> running{0};
+            std::atomic<int> leaked{0};
+            std::thread controller([&] {
+                while (running.load(std::memory_order_acquire) < kThreads) {
+                    std::this_thread::yield();
+                }
+                if (kind == 0) {
+                    risk_manager.haltTrading();
+                } else {
+                    risk_manager.suspendTrader(trader);
+                }
+                engaged.store(true, std::memory_order_release);
+            });
+            runConcurrently(kThreads, [&](unsigned) {
+                running.fetch_add(1, std::memory_order_release);
+                int after = 0;
+                while (after < kKillIterations) {
+                    const bool seen = engaged.load(std::memory_order_acquire);
+                    RiskDecision decision = validateThenCancel(risk_manager, hot, trader);
+                    if (seen) {
+                        ++after;
+                        leaked.fetch_add(decision.reason != expected, std::memory_order_relaxed);
+                    }
+                }
+            });
+            controller.join();
+            if (leaked.load() != 0) {
+                fail(kind == 0 ? "order accepted after the firm halt" : "order accepted after the trader suspension",
+                     round);
+            }
+            if (kind == 0) {
+                risk_manager.resumeTrading();
+            } else {
+                risk_manager.resumeTrader(trader);
             }
+            if (!risk_manager.validateTradeOrder(hot, trader)) {
+                fail("order rejected after the kill switch was lifted", round);
+            }
+            risk_manager.releaseTradeSlot(trader);
         }
-        
-        return true;
     }
-    
-    // Business Rule: Order routing and execution rules
-    bool validateOrderExecution(const TradeOrder& order, const std::string& venue) {
-        // Business Rule: Large order routing requirements
-        if (order.quantity * order.price > 500000.0) {
-            if (venue != "DARK_POOL" && venue != "INSTITUTIONAL_NETWORK") {
-                std::cout << "WARNING: Large orders should use dark pools" << std::endl;
+    if (failures != 0) {
+        std::cout << "concurrency check FAILED: " << failures << " failures over " << kRounds << " rounds"
+                  << std::endl;
+        return 1;
+    }
+    std::cout << "concurrency check passed: " << kRounds << " rounds of " << kThreads
+              << " threads on one trader" << std::endl;
+    return 0;
+}
+
+// Self-test: readers racing a publisher on MarketConditionsSeqlock must
+// only ever see a field set that was published as a whole, in publish
+// order; and checkMarketConditions() on a manager whose snapshots alternate
+// between a VIX halt and a closed market, where only a torn read could be
+// accepted, must reject every time. Returns non-zero on failure.
+int runMarketCheck() {
+    const unsigned kReaders = 7;
+    const uint32_t kPublishes = 2000000;
+
+    // Every field of snapshot k is derived from k, so a reader can tell a
+    // mix of two publishes from a whole one
+    auto conditionsFor = [](uint32_t k) {
+        return MarketConditions{k + 0.5, static_cast<MarketStatus>(1 + k % 3), k};
+    };
+
+    MarketConditionsSeqlock market;
+    market.publish(conditionsFor(0));
+    std::atomic<bool> publishing{true};
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> out_of_order{0};
+    std::atomic<uint64_t> reads{0};
+    runConcurrently(kReaders + 1, [&](unsigned t) {
+        if (t == 0) {
+            for (uint32_t k = 1; k <= kPublishes; ++k) {
+                market.publish(conditionsFor(k));
             }
+            publishing.store(false, std::memory_order_release);
+            return;
         }
-        
-        // Business Rule: Best execution requirements
-        if (order.order_type == "MARKET" && order.quantity > 10000) {
-            std::cout << "WARNING: Large market orders may have price impact" << std::endl;
+        uint32_t last = 0;
+        uint64_t local_reads = 0;
+        while (publishing.load(std::memory_order_acquire)) {
+            MarketConditions seen = market.read();
+            MarketConditions expected = conditionsFor(seen.halt_flags);
+            torn.fetch_add((seen.vix != expected.vix) | (seen.status != expected.status),
+                           std::memory_order_relaxed);
+            out_of_order.fetch_add(seen.halt_flags < last, std::memory_order_relaxed);
+            last = seen.halt_flags;
+            ++local_reads;
         }
-        
-        // Business Rule: Venue-specific restrictions
-        if (venue == "RETAIL_VENUE" && order.quantity > 100000) {
-            std::cout << "REJECTED: Order too large for retail venue" << std::endl;
-            return false;
+        reads.fetch_add(local_reads, std::memory_order_relaxed);
+    });
+
+    TradingRiskManager risk_manager;
+    const MarketConditions vix_halt = {FirmLimits::VIX_HALT_THRESHOLD + 10.0, MarketStatus::OPEN, 0};
+    const MarketConditions closed = {FirmLimits::VIX_HALT_THRESHOLD - 10.0, MarketStatus::CLOSED, 0};
+    risk_manager.publishMarketConditions(vix_halt);
+    std::atomic<bool> alternating{true};
+    std::atomic<uint64_t> accepted{0};
+    runConcurrently(kReaders + 1, [&](unsigned t) {
+        if (t == 0) {
+            for (uint32_t k = 0; k < kPublishes; ++k) {
+                risk_manager.publishMarketConditions(k & 1 ? vix_halt : closed);
+            }
+            alternating.store(false, std::memory_order_release);
+            return;
         }
-        
-        return true;
+        while (alternating.load(std::memory_order_acquire)) {
+            accepted.fetch_add(risk_manager.checkMarketConditions().accepted, std::memory_order_relaxed);
+        }
+    });
+
+    if (torn.load() != 0 || out_of_order.load() != 0 || accepted.load() != 0) {
+        std::cout << "market check FAILED: " << torn.load() << " torn snapshots, " << out_of_order.load()
+                  << " out of publish order, " << accepted.load() << " torn decisions accepted" << std::endl;
+        return 1;
     }
-};
+    std::cout << "market check passed: " << reads.load() << " reads by " << kReaders << " threads across "
+              << kPublishes << " publishes, no torn or reordered snapshot" << std::endl;
+    return 0;
+}
 
-// Business Rule: Risk scoring algorithm
-double calculateRiskScore(const TraderProfile& trader, const TradeOrder& order) {
-    double risk_score = 0.0;
-    
-    // Business Rule: Experience factor
-    if (trader.experience_years < 3) {
-        risk_score += 0.3;
+// Self-test: readers pinning ReloadableLimitsPolicy snapshots while a
+// reloader keeps swapping limit sets must only see whole sets, in reload
+// order, that stay unchanged for as long as the snapshot is held (a set
+// freed under a reader would be reused by the next reload and change).
+// Returns non-zero on failure; a -fsanitize=address build also catches
+// the use-after-free directly. The readers run once with slots of their
+// own and once past kMaxReaderThreads, on the shared overflow counters.
+int runReloadCheck() {
+    const unsigned kReaders = 7;
+    const int kReloads = 20000;
+
+    // Every limit of set g is derived from g, so a reader can tell a torn
+    // or recycled set from a whole one
+    auto limitsFor = [](int g) {
+        LimitSet limits = LimitSet::firmDefaults();
+        limits.MAX_TRADES_PER_DAY = g;
+        limits.MAX_ORDER_SIZE = Fixed{g * 3 + 1};
+        limits.MAX_DAILY_LOSS = Fixed{g * 7 + 2};
+        limits.MAX_POSITION_SIZE = g * 0.5;
+        return limits;
+    };
+    auto wholeSet = [&](const LimitSet& limits) {
+        const LimitSet expected = limitsFor(limits.MAX_TRADES_PER_DAY);
+        return limits.MAX_ORDER_SIZE == expected.MAX_ORDER_SIZE &&
+               limits.MAX_DAILY_LOSS == expected.MAX_DAILY_LOSS &&
+               limits.MAX_POSITION_SIZE == expected.MAX_POSITION_SIZE;
+    };
+
+    ReloadableLimitsPolicy policy;
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> out_of_order{0};
+    std::atomic<uint64_t> changed{0};
+    std::atomic<uint64_t> snapshots{0};
+    auto readWhileReloading = [&] {
+        policy.load(limitsFor(0));
+        std::atomic<bool> reloading{true};
+        std::atomic<unsigned> reading{0};
+        runConcurrently(kReaders + 1, [&](unsigned t) {
+            if (t == 0) {
+                // Every reader is in its loop before the first reload
+                while (reading.load(std::memory_order_acquire) != kReaders) {
+                    std::this_thread::yield();
+                }
+                for (int g = 1; g <= kReloads; ++g) {
+                    policy.load(limitsFor(g));
+                }
+                reloading.store(false, std::memory_order_release);
+                return;
+            }
+            int last = 0;
+            uint64_t local = 0;
+            reading.fetch_add(1, std::memory_order_release);
+            while (reloading.load(std::memory_order_acquire)) {
+                const auto lim = policy.snapshot();
+                const LimitSet first = *lim.operator->();
+                torn.fetch_add(!wholeSet(first), std::memory_order_relaxed);
+                out_of_order.fetch_add(first.MAX_TRADES_PER_DAY < last, std::memory_order_relaxed);
+                last = first.MAX_TRADES_PER_DAY;
+                // Hold the snapshot across a reload, nesting a second one
+                if (local % 16 == 0) {
+                    std::this_thread::yield();
+                    const auto inner = policy.snapshot();
+                    torn.fetch_add(!wholeSet(*inner.operator->()), std::memory_order_relaxed);
+                    out_of_order.fetch_add(inner->MAX_TRADES_PER_DAY < last, std::memory_order_relaxed);
+                }
+                changed.fetch_add(std::memcmp(&first, lim.operator->(), sizeof(LimitSet)) != 0,
+                                  std::memory_order_relaxed);
+                ++local;
+            }
+            snapshots.fetch_add(local, std::memory_order_relaxed);
+        });
+    };
+
+    // Once with a slot per reader, then with every slot held by an idle
+    // thread, so the readers all count into the overflow counters
+    readWhileReloading();
+    std::mutex gate;
+    std::condition_variable gate_changed;
+    unsigned holding = 0;
+    bool release = false;
+    std::vector<std::thread> holders;
+    for (unsigned h = 0; h < ReloadableLimitsPolicy::kMaxReaderThreads; ++h) {
+        holders.emplace_back([&] {
+            policy.snapshot();
+            std::unique_lock<std::mutex> lock(gate);
+            ++holding;
+            gate_changed.notify_all();
+            gate_changed.wait(lock, [&] { return release; });
+        });
     }
-    
-    // Business Rule: Account size factor
-    if (trader.account_balance < 100000.0) {
-        risk_score += 0.2;
+    {
+        std::unique_lock<std::mutex> lock(gate);
+        gate_changed.wait(lock, [&] { return holding == ReloadableLimitsPolicy::kMaxReaderThreads; });
     }
-    
-    // Business Rule: Order size factor
-    double order_value = order.quantity * order.price;
-    if (order_value > trader.account_balance * 0.1) {
-        risk_score += 0.4;
+    readWhileReloading();
+    {
+        std::lock_guard<std::mutex> lock(gate);
+        release = true;
     }
-    
-    // Business Rule: Volatility factor
-    risk_score += order.volatility_score * 0.5;
-    
-    // Business Rule: Sector risk factor
-    if (order.sector == "BIOTECH" || order.sector == "CRYPTO") {
-        risk_score += 0.3;
+    gate_changed.notify_all();
+    for (auto& holder : holders) {
+        holder.join();
     }
-    
-    return risk_score;
+
+    if (torn.load() != 0 || out_of_order.load() != 0 || changed.load() != 0) {
+        std::cout << "reload check FAILED: " << torn.load() << " torn sets, " << out_of_order.load()
+                  << " out of reload order, " << changed.load() << " changed while pinned" << std::endl;
+        return 1;
+    }
+    std::cout << "reload check passed: " << snapshots.load() << " snapshots by " << kReaders << " threads across "
+              << kReloads << " reloads (" << (AsymmetricFence::expedited() ? "membarrier" : "fence")
+              << " read path), with own slots and on the overflow counters; no torn, reordered or freed set seen"
+              << std::endl;
+    return 0;
 }
 
-int main() {
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        return runBenchmarks();
+    }
+    if (argc > 1 && std::string(argv[1]) == "--alloc-check") {
+        return runAllocationCheck();
+    }
+    if (argc > 1 && std::string(argv[1]) == "--portfolio-check") {
+        return runPortfolioCheck();
+    }
+    if (argc > 1 && std::string(argv[1]) == "--concurrency-check") {
+        return runConcurrencyCheck();
+    }
+    if (argc > 1 && std::string(argv[1]) == "--market-check") {
+        return runMarketCheck();
+    }
+    if (argc > 1 && std::string(argv[1]) == "--reload-check") {
+        return runReloadCheck();
+    }
+
     TradingRiskManager risk_manager;
     
     // Sample trader profile
@@ -363,6 +5241,7 @@ int main() {
         true,
         "US"
     };
+    risk_manager.loginTrader(trader);
     
     // Sample trade order
     TradeOrder order = {
@@ -378,9 +5257,14 @@ int main() {
     };
     
     // Validate trader and order
-    if (risk_manager.validateTraderEligibility(trader)) {
-        if (risk_manager.validateTradeOrder(order, trader)) {
+    RiskDecision eligibility = risk_manager.validateTraderEligibility(trader);
+    printRiskDecision(std::cout, eligibility);
+    if (eligibility) {
+        RiskDecision decision = risk_manager.validateTradeOrder(order, trader);
+        printRiskDecision(std::cout, decision);
+        if (decision) {
             std::cout << "ORDER APPROVED" << std::endl;
+            risk_manager.commitTradeSlot(trader);
         }
     }
     